@@ -0,0 +1,105 @@
+#ifndef HULK_AST_ARENA_HPP
+#define HULK_AST_ARENA_HPP 1
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hulk {
+    namespace ast {
+
+        // Bump-pointer allocator that owns every node of a program.
+        // Nodes are carved out of large blocks and handed out as plain
+        // pointers; nothing is freed one by one. When the arena dies the
+        // destructors of the nodes that need one run (newest first) and the
+        // blocks are released together.
+        // The arena can be moved (the parser builds the tree and hands its
+        // arena to ast::program) but nodes never move, so pointers stay valid
+        // for the whole life of the program.
+        struct ast_arena {
+            static constexpr std::size_t block_size = 64 * 1024;
+
+            ast_arena() = default;
+
+            ast_arena(ast_arena&& other) noexcept
+                : blocks(std::move(other.blocks)),
+                finalizers(std::move(other.finalizers)),
+                cursor(std::exchange(other.cursor, nullptr)),
+                limit(std::exchange(other.limit, nullptr)),
+                used(std::exchange(other.used, 0)) {
+                other.blocks.clear();
+                other.finalizers.clear();
+            }
+
+            ast_arena(const ast_arena&) = delete;
+            ast_arena& operator=(const ast_arena&) = delete;
+            ast_arena& operator=(ast_arena&&) = delete;
+
+            ~ast_arena() {
+                for (auto it = finalizers.rbegin(); it != finalizers.rend(); ++it)
+                    it->destroy(it->object);
+            }
+
+            // Construct a T inside the arena
+            template <class T, class... Args>
+            T* make(Args&&... args) {
+                void* memory = allocate(sizeof(T), alignof(T));
+                T* node = new (memory) T(std::forward<Args>(args)...);
+                if constexpr (!std::is_trivially_destructible_v<T>)
+                    finalizers.push_back({ node, [](void* object) { static_cast<T*>(object)->~T(); } });
+                return node;
+            }
+
+            // Take ownership of every node of other (e.g. a subtree parsed on
+            // another thread); those nodes keep their addresses and die
+            // with this arena
+            void absorb(ast_arena&& other) {
+                blocks.insert(blocks.end(), std::make_move_iterator(other.blocks.begin()), std::make_move_iterator(other.blocks.end()));
+                finalizers.insert(finalizers.end(), other.finalizers.begin(), other.finalizers.end());
+                used += std::exchange(other.used, 0);
+                other.blocks.clear();
+                other.finalizers.clear();
+                other.cursor = other.limit = nullptr;
+            }
+
+            // Bytes handed out to nodes so far
+            std::size_t bytes_used() const { return used; }
+
+        private:
+            struct finalizer {
+                void* object;
+                void (*destroy)(void*);
+            };
+
+            std::vector<std::unique_ptr<char[]>> blocks;
+            std::vector<finalizer> finalizers;
+            char* cursor = nullptr;
+            char* limit = nullptr;
+            std::size_t used = 0;
+
+            void* allocate(std::size_t size, std::size_t align) {
+                std::size_t padding = (align - reinterpret_cast<std::uintptr_t>(cursor) % align) % align;
+                if (!cursor || padding + size > static_cast<std::size_t>(limit - cursor)) {
+                    // nodes bigger than a block get a block of their own
+                    std::size_t capacity = std::max(block_size, size + align);
+                    blocks.emplace_back(new char[capacity]);  // left uninitialized
+                    cursor = blocks.back().get();
+                    limit = cursor + capacity;
+                    padding = (align - reinterpret_cast<std::uintptr_t>(cursor) % align) % align;
+                }
+                void* memory = cursor + padding;
+                cursor += padding + size;
+                used += size;
+                return memory;
+            }
+        };
+
+    }  // namespace ast
+}  // namespace hulk
+
+#endif  // HULK_AST_ARENA_HPP
@@ -22,13 +22,16 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 #include <string>
 
+#include "arena"
 #include "enums"
 #include "../internal/internal_uncopyable"
 #include "../internal/internal_error"
+#include "../internal/internal_stack"
 #include "../semantic/context"
 
 namespace hulk {
@@ -37,7 +40,7 @@ namespace hulk {
     static std::unique_ptr<llvm::LLVMContext> TheContext;
     static std::unique_ptr<llvm::Module> TheModule;
     static std::unique_ptr<llvm::IRBuilder<>> Builder;
-    static std::map<std::string, llvm::AllocaInst*> NamedValues;
+    static std::unordered_map<lexer::symbol, llvm::AllocaInst*> NamedValues;
 
     static std::map<std::string, std::map<std::string, unsigned>> StructFieldIndices;
 
@@ -68,21 +71,21 @@ namespace hulk {
     struct block_expr;
     struct new_expr;
 
-    // Define smart pointers for expressions
-    using expr_ptr = std::unique_ptr<expr>;
-    using binary_expr_ptr = std::unique_ptr<binary_expr>;
-    using call_expr_ptr = std::unique_ptr<call_expr>;
-    using literal_expr_ptr = std::unique_ptr<literal_expr>;
-    using unary_expr_ptr = std::unique_ptr<unary_expr>;
-    using assign_expr_ptr = std::unique_ptr<assign_expr>;
-    using declaration_expr_ptr = std::unique_ptr<declaration_expr>;
-    using let_expr_ptr = std::unique_ptr<let_expr>;
-    using while_expr_ptr = std::unique_ptr<while_expr>;
-    using for_expr_ptr = std::unique_ptr<for_expr>;
-    using var_expr_ptr = std::unique_ptr<var_expr>;
-    using if_expr_ptr = std::unique_ptr<if_expr>;
-    using block_expr_ptr = std::unique_ptr<block_expr>;
-    using new_expr_ptr = std::unique_ptr<new_expr>;
+    // Node handles: plain pointers into the ast_arena of the program
+    using expr_ptr = expr*;
+    using binary_expr_ptr = binary_expr*;
+    using call_expr_ptr = call_expr*;
+    using literal_expr_ptr = literal_expr*;
+    using unary_expr_ptr = unary_expr*;
+    using assign_expr_ptr = assign_expr*;
+    using declaration_expr_ptr = declaration_expr*;
+    using let_expr_ptr = let_expr*;
+    using while_expr_ptr = while_expr*;
+    using for_expr_ptr = for_expr*;
+    using var_expr_ptr = var_expr*;
+    using if_expr_ptr = if_expr*;
+    using block_expr_ptr = block_expr*;
+    using new_expr_ptr = new_expr*;
 
     struct expr : private internal::uncopyable {
       virtual void scoped_visit(semantic::context& ctx) const {}
@@ -322,14 +325,14 @@ namespace hulk {
     struct field_stmt;
     struct super_item;
 
-    // Define smart pointers for statements
-    using stmt_ptr = std::shared_ptr<stmt>;
-    using expression_stmt_ptr = std::shared_ptr<expression_stmt>;
-    using function_stmt_ptr = std::shared_ptr<function_stmt>;
-    using class_stmt_ptr = std::shared_ptr<class_stmt>;
-    using protocol_stmt_ptr = std::shared_ptr<protocol_stmt>;
-    using field_stmt_ptr = std::shared_ptr<field_stmt>;
-    using super_item_ptr = std::shared_ptr<super_item>;
+    // Node handles: plain pointers into the ast_arena of the program
+    using stmt_ptr = stmt*;
+    using expression_stmt_ptr = expression_stmt*;
+    using function_stmt_ptr = function_stmt*;
+    using class_stmt_ptr = class_stmt*;
+    using protocol_stmt_ptr = protocol_stmt*;
+    using field_stmt_ptr = field_stmt*;
+    using super_item_ptr = super_item*;
 
     struct stmt : private internal::uncopyable {
       virtual void context_builder_visit(semantic::context& ctx) {}
@@ -439,11 +442,15 @@ namespace hulk {
 
     // Program
     struct program : private internal::uncopyable {
+      // Owns every node of the tree, which is freed with the program. It is
+      // mutable because the semantic passes still add a few nodes (the
+      // implicit Object parent of a type and its forwarded arguments).
+      mutable ast_arena arena;
       std::vector<stmt_ptr> statements;
       expr_ptr main;
 
-      explicit program(std::vector<stmt_ptr> _statements, expr_ptr _main)
-        : statements(std::move(_statements)), main(std::move(_main)) {
+      explicit program(ast_arena _arena, std::vector<stmt_ptr> _statements, expr_ptr _main)
+        : arena(std::move(_arena)), statements(std::move(_statements)), main(_main) {
       }
 
       void context_builder_visit(semantic::context& ctx) const;
@@ -0,0 +1,370 @@
+#ifndef HULK_AST_FLAT_HPP
+#define HULK_AST_FLAT_HPP 1
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ast.hpp"
+#include "enums"
+
+namespace hulk {
+  namespace ast {
+
+    // Flat representation of a program
+    //
+    // Each node kind lives in its own contiguous pool and children are 32-bit
+    // indices instead of pointers. An expression is a node_id: kinds[id] says
+    // which pool it is in and slots[id] where. Variable-length children (block
+    // bodies, arguments, let declarations, elif branches) are ranges of the
+    // shared children list, and every token a node keeps is an index into
+    // tokens. Having no pointers, it is the layout the binary AST image is
+    // written in (serialize.hpp); the passes run on the pointer tree.
+    //
+    // It is built from an ast::program with flatten(), which copies the tree
+    // as it is at that moment (after the context builder, which still adds
+    // nodes). Like the pointer tree it does not own the source text.
+
+    using node_id = uint32_t;
+    constexpr node_id no_node = std::numeric_limits<node_id>::max();
+
+    enum class node_kind : uint8_t {
+      BLOCK,
+      BINARY,
+      UNARY,
+      LITERAL,
+      NEW,
+      CALL,
+      LET,
+      ASSIGN,
+      DECLARATION,
+      IF,
+      WHILE,
+      FOR,
+      VAR
+    };
+
+    // [first, first + count) of one of the pools
+    struct node_range {
+      uint32_t first = 0;
+      uint32_t count = 0;
+    };
+
+    struct flat_program {
+      // Expressions
+      struct binary_node {
+        node_id left, right;
+        uint32_t token;
+        binary_op op;
+      };
+
+      struct unary_node {
+        node_id expression;
+        uint32_t token;
+        unary_op op;
+      };
+
+      struct var_node {
+        node_id object;  // no_node when there is none
+        uint32_t name;
+      };
+
+      struct call_node {
+        node_id object;  // no_node when there is none
+        uint32_t callee;
+        node_range arguments;
+      };
+
+      struct new_node {
+        uint32_t type_name;
+        node_range arguments;
+      };
+
+      struct let_node {
+        node_range assignments;  // DECLARATION nodes
+        node_id body;
+      };
+
+      struct assign_node {
+        node_id variable, value;
+        uint32_t type;
+      };
+
+      struct declaration_node {
+        uint32_t name, type;
+        node_id value;
+      };
+
+      struct if_node {
+        uint32_t condition_token;
+        node_id condition, then_branch;
+        node_range elifs;      // condition and branch of each elif, in pairs
+        node_range elif_tokens;
+        node_id else_branch;   // no_node when there is none
+      };
+
+      struct while_node {
+        uint32_t condition_token;
+        node_id condition, body;
+      };
+
+      struct for_node {
+        uint32_t var_name, var_type;
+        node_id iterable, body;
+      };
+
+      // Statements
+      enum class stmt_kind : uint8_t { FUNCTION, CLASS, PROTOCOL, EXPRESSION };
+
+      struct stmt_ref {
+        stmt_kind kind;
+        uint32_t slot;
+      };
+
+      struct parameter_node {
+        uint32_t name, type;
+      };
+
+      struct function_node {
+        uint32_t name;
+        function_type type;
+        node_range parameters;
+        node_id body;  // no_node for protocol signatures
+        uint32_t return_type;
+      };
+
+      struct field_node {
+        uint32_t name, type;
+        node_id initializer;
+      };
+
+      struct class_node {
+        uint32_t name;
+        node_range parameters;
+        bool has_super;
+        uint32_t super_name;
+        node_range super_init;
+        node_range fields;   // in the fields pool
+        node_range methods;  // in the functions pool
+      };
+
+      struct protocol_node {
+        uint32_t name;
+        node_range methods;  // in the functions pool
+        uint32_t super_protocol;
+      };
+
+      std::vector<node_kind> kinds;
+      std::vector<uint32_t> slots;
+
+      std::vector<binary_node> binaries;
+      std::vector<unary_node> unaries;
+      std::vector<lexer::literal> literals;
+      std::vector<var_node> vars;
+      std::vector<call_node> calls;
+      std::vector<new_node> news;
+      std::vector<let_node> lets;
+      std::vector<assign_node> assigns;
+      std::vector<declaration_node> declarations;
+      std::vector<if_node> ifs;
+      std::vector<while_node> whiles;
+      std::vector<for_node> fors;
+      std::vector<node_range> blocks;
+
+      std::vector<node_id> children;
+      std::vector<uint32_t> token_lists;
+      std::vector<lexer::token> tokens;
+
+      std::vector<stmt_ref> statements;
+      std::vector<parameter_node> parameters;
+      std::vector<function_node> functions;
+      std::vector<field_node> fields;
+      std::vector<class_node> classes;
+      std::vector<protocol_node> protocols;
+      std::vector<node_id> expression_stmts;
+
+      node_id main = no_node;
+
+      size_t size() const { return kinds.size(); }
+    };
+
+    // Builds a flat_program from the pointer tree (children before parents,
+    // so a node's children always have smaller ids)
+    struct flattener {
+      flat_program& out;
+
+      template <class T>
+      node_id add(node_kind kind, std::vector<T>& pool, T node) {
+        out.kinds.push_back(kind);
+        out.slots.push_back(static_cast<uint32_t>(pool.size()));
+        pool.push_back(std::move(node));
+        return static_cast<node_id>(out.kinds.size() - 1);
+      }
+
+      uint32_t token(const lexer::token& t) {
+        out.tokens.push_back(t);
+        return static_cast<uint32_t>(out.tokens.size() - 1);
+      }
+
+      node_id optional(const std::optional<expr_ptr>& e) {
+        return e && *e ? expression(*e) : no_node;
+      }
+
+      // the children are flattened first so that their ids can be written
+      // contiguously in children
+      node_range list(const std::vector<expr_ptr>& exprs) {
+        std::vector<node_id> ids;
+        ids.reserve(exprs.size());
+        for (const auto& e : exprs) ids.push_back(expression(e));
+        return append(ids);
+      }
+
+      node_range append(const std::vector<node_id>& ids) {
+        node_range range{ static_cast<uint32_t>(out.children.size()), static_cast<uint32_t>(ids.size()) };
+        out.children.insert(out.children.end(), ids.begin(), ids.end());
+        return range;
+      }
+
+      node_id expression(const expr* e) {
+        if (!e) return no_node;
+        if (internal::stack_exhausted())
+          return internal::grow_stack([&] { return expression(e); });
+
+        if (auto* n = dynamic_cast<const binary_expr*>(e)) {
+          node_id left = expression(n->left), right = expression(n->right);
+          return add(node_kind::BINARY, out.binaries, { left, right, token(n->token), n->op });
+        }
+        if (auto* n = dynamic_cast<const literal_expr*>(e))
+          return add(node_kind::LITERAL, out.literals, n->value);
+        if (auto* n = dynamic_cast<const var_expr*>(e)) {
+          node_id object = optional(n->object);
+          return add(node_kind::VAR, out.vars, { object, token(n->name) });
+        }
+        if (auto* n = dynamic_cast<const call_expr*>(e)) {
+          node_id object = optional(n->object);
+          node_range arguments = list(n->arguments);
+          return add(node_kind::CALL, out.calls, { object, token(n->callee), arguments });
+        }
+        if (auto* n = dynamic_cast<const block_expr*>(e))
+          return add(node_kind::BLOCK, out.blocks, list(n->expressions));
+        if (auto* n = dynamic_cast<const unary_expr*>(e)) {
+          node_id operand = expression(n->expression);
+          return add(node_kind::UNARY, out.unaries, { operand, token(n->token), n->op });
+        }
+        if (auto* n = dynamic_cast<const let_expr*>(e)) {
+          std::vector<node_id> ids;
+          for (const auto& d : n->assignments) ids.push_back(expression(d));
+          node_range assignments = append(ids);
+          node_id body = expression(n->body);
+          return add(node_kind::LET, out.lets, { assignments, body });
+        }
+        if (auto* n = dynamic_cast<const declaration_expr*>(e)) {
+          node_id value = expression(n->value);
+          return add(node_kind::DECLARATION, out.declarations, { token(n->name), token(n->type), value });
+        }
+        if (auto* n = dynamic_cast<const assign_expr*>(e)) {
+          node_id variable = expression(n->variable), value = expression(n->value);
+          return add(node_kind::ASSIGN, out.assigns, { variable, value, token(n->type) });
+        }
+        if (auto* n = dynamic_cast<const if_expr*>(e)) {
+          node_id condition = expression(n->condition), then_branch = expression(n->then_branch);
+          std::vector<node_id> ids;
+          for (const auto& [c, b] : n->elif_branchs) {
+            ids.push_back(expression(c));
+            ids.push_back(expression(b));
+          }
+          node_range elifs = append(ids);
+          node_range elif_tokens{ static_cast<uint32_t>(out.token_lists.size()), static_cast<uint32_t>(n->elif_tokens.size()) };
+          for (const auto& t : n->elif_tokens) out.token_lists.push_back(token(t));
+          node_id else_branch = optional(n->else_branch);
+          return add(node_kind::IF, out.ifs, { token(n->condition_token), condition, then_branch, elifs, elif_tokens, else_branch });
+        }
+        if (auto* n = dynamic_cast<const while_expr*>(e)) {
+          node_id condition = expression(n->condition), body = expression(n->body);
+          return add(node_kind::WHILE, out.whiles, { token(n->condition_token), condition, body });
+        }
+        if (auto* n = dynamic_cast<const for_expr*>(e)) {
+          node_id iterable = expression(n->iterable), body = expression(n->body);
+          return add(node_kind::FOR, out.fors, { token(n->var_name), token(n->var_type), iterable, body });
+        }
+        if (auto* n = dynamic_cast<const new_expr*>(e)) {
+          node_range arguments = list(n->arguments);
+          return add(node_kind::NEW, out.news, { token(n->type_name), arguments });
+        }
+        return no_node;
+      }
+
+      node_range parameters(const std::vector<parameter>& params) {
+        node_range range{ static_cast<uint32_t>(out.parameters.size()), static_cast<uint32_t>(params.size()) };
+        for (const auto& p : params) {
+          uint32_t name = token(p.name);
+          out.parameters.push_back({ name, token(p.type) });
+        }
+        return range;
+      }
+
+      // function bodies never declare functions, fields or parameters, so
+      // the records of a class's methods and fields end up contiguous
+      uint32_t function(const function_stmt* f) {
+        flat_program::function_node record{ token(f->name), f->type, parameters(f->parameters), expression(f->body), token(f->return_type) };
+        out.functions.push_back(record);
+        return static_cast<uint32_t>(out.functions.size() - 1);
+      }
+
+      node_range functions(const std::vector<function_stmt_ptr>& fns) {
+        node_range range{ static_cast<uint32_t>(out.functions.size()), static_cast<uint32_t>(fns.size()) };
+        for (const auto& f : fns) function(f);
+        return range;
+      }
+
+      void statement(const stmt* s) {
+        using kind = flat_program::stmt_kind;
+
+        if (auto* f = dynamic_cast<const function_stmt*>(s)) {
+          out.statements.push_back({ kind::FUNCTION, function(f) });
+        }
+        else if (auto* c = dynamic_cast<const class_stmt*>(s)) {
+          flat_program::class_node record{};
+          record.name = token(c->name);
+          record.parameters = parameters(c->parameters);
+          record.has_super = c->super_class.has_value();
+          if (record.has_super) {
+            record.super_name = token((*c->super_class)->name);
+            record.super_init = list((*c->super_class)->init);
+          }
+          record.fields = { static_cast<uint32_t>(out.fields.size()), static_cast<uint32_t>(c->fields.size()) };
+          for (const auto& field : c->fields) {
+            uint32_t name = token(field->name), type = token(field->type);
+            out.fields.push_back({ name, type, expression(field->initializer) });
+          }
+          record.methods = functions(c->methods);
+          out.statements.push_back({ kind::CLASS, static_cast<uint32_t>(out.classes.size()) });
+          out.classes.push_back(record);
+        }
+        else if (auto* p = dynamic_cast<const protocol_stmt*>(s)) {
+          uint32_t name = token(p->name);
+          node_range methods = functions(p->methods);
+          out.statements.push_back({ kind::PROTOCOL, static_cast<uint32_t>(out.protocols.size()) });
+          out.protocols.push_back({ name, methods, token(p->super_protocol) });
+        }
+        else if (auto* e = dynamic_cast<const expression_stmt*>(s)) {
+          out.statements.push_back({ kind::EXPRESSION, static_cast<uint32_t>(out.expression_stmts.size()) });
+          out.expression_stmts.push_back(expression(e->expression));
+        }
+      }
+    };
+
+    flat_program flatten(const program& tree) {
+      flat_program out;
+      flattener builder{ out };
+      for (const auto& s : tree.statements)
+        builder.statement(s);
+      out.main = builder.expression(tree.main);
+      return out;
+    }
+
+  }  // namespace ast
+}  // namespace hulk
+
+#endif  // HULK_AST_FLAT_HPP
@@ -0,0 +1,668 @@
+#ifndef HULK_AST_SERIALIZE_HPP
+#define HULK_AST_SERIALIZE_HPP 1
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "ast.hpp"
+#include "flat.hpp"
+
+namespace hulk {
+  namespace ast {
+
+    // Binary image of a flat_program
+    //
+    // The image is a header, a table of sections and the sections themselves,
+    // each one an array of trivially copyable records aligned to 8 bytes. The
+    // pools of flat_program are written as they are; tokens and literals,
+    // which hold strings, are written as packed_token / packed_literal with
+    // their text in a shared string table (the value of a token is one more
+    // literal). Reading an image copies nothing: the sections are used in
+    // place (straight from an mmap'ed file) and a statement is turned back
+    // into nodes only when it is asked for.
+    //
+    // The header carries a key chosen by the writer (e.g. a hash of the
+    // source the image was built from); open() rejects an image whose key,
+    // version or layout does not match.
+
+    constexpr char image_magic[8] = { 'H', 'U', 'L', 'K', 'I', 'M', 'G', '\0' };
+    constexpr uint32_t image_version = 2;
+    constexpr uint32_t no_string = std::numeric_limits<uint32_t>::max();
+
+    struct image_header {
+      char magic[8];
+      uint32_t version;
+      uint32_t sections;
+      uint64_t key;
+      uint64_t size;  // of the whole image, in bytes
+    };
+
+    struct section_entry {
+      uint64_t offset;
+      uint64_t count;
+    };
+
+    struct packed_literal {
+      uint32_t kind;  // index in lexer::literal
+      uint32_t text;  // string, for kind 1
+      double number;  // number or boolean, for kinds 2 and 3
+    };
+
+    struct packed_token {
+      uint16_t type;
+      uint16_t has_id;  // identifiers and names added by the passes
+      uint32_t lexeme;
+      uint32_t line, column;
+      uint32_t value;  // in LITERALS, no_string for none
+    };
+
+    // Sections of a flat_program, in file order. Other images can append
+    // their own sections after ast_sections.
+    enum image_section : uint32_t {
+      STRING_OFFSETS,  // n + 1 offsets into STRING_DATA
+      STRING_DATA,
+      KINDS,
+      SLOTS,
+      BINARIES,
+      UNARIES,
+      LITERALS,
+      VARS,
+      CALLS,
+      NEWS,
+      LETS,
+      ASSIGNS,
+      DECLARATIONS,
+      IFS,
+      WHILES,
+      FORS,
+      BLOCKS,
+      CHILDREN,
+      TOKEN_LISTS,
+      TOKENS,
+      STATEMENTS,
+      PARAMETERS,
+      FUNCTIONS,
+      FIELDS,
+      CLASSES,
+      PROTOCOLS,
+      EXPRESSION_STMTS,
+      ast_sections
+    };
+
+    // range lies inside a section of count records
+    inline bool in_bounds(node_range range, size_t count) {
+      return range.first <= count && range.count <= count - range.first;
+    }
+
+    template <class T>
+    struct array_view {
+      const T* items = nullptr;
+      size_t count = 0;
+
+      const T& operator[](size_t i) const { return items[i]; }
+      size_t size() const { return count; }
+      const T* begin() const { return items; }
+      const T* end() const { return items + count; }
+    };
+
+    struct image_writer {
+      image_writer() : sections(ast_sections) {}
+
+      uint32_t string(std::string_view text) {
+        auto it = strings.find(std::string(text));
+        if (it != strings.end()) return it->second;
+
+        uint32_t id = static_cast<uint32_t>(offsets.size());
+        offsets.push_back(static_cast<uint32_t>(data.size()));
+        data.append(text);
+        strings.emplace(std::string(text), id);
+        return id;
+      }
+
+      template <class T>
+      void section(uint32_t index, const std::vector<T>& records) {
+        static_assert(std::is_trivially_copyable_v<T>, "sections are copied byte by byte");
+        if (index >= sections.size()) sections.resize(index + 1);
+        sections[index].count = records.size();
+        sections[index].bytes.assign(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+      }
+
+      // Writes every pool of program
+      void write(const flat_program& program) {
+        // literal nodes first, so that their slots stay valid, then the
+        // values tokens carry
+        std::vector<packed_literal> literals;
+        for (const auto& l : program.literals) literals.push_back(literal(l));
+        std::vector<packed_token> tokens;
+        for (const auto& t : program.tokens) {
+          uint32_t value = no_string;
+          if (t.value.index() != 0) {
+            value = static_cast<uint32_t>(literals.size());
+            literals.push_back(literal(t.value));
+          }
+          tokens.push_back({ static_cast<uint16_t>(t.type), t.id != lexer::empty_symbol, string(t.lexeme), t.line, t.column, value });
+        }
+
+        section(KINDS, program.kinds);
+        section(SLOTS, program.slots);
+        section(BINARIES, program.binaries);
+        section(UNARIES, program.unaries);
+        section(LITERALS, literals);
+        section(VARS, program.vars);
+        section(CALLS, program.calls);
+        section(NEWS, program.news);
+        section(LETS, program.lets);
+        section(ASSIGNS, program.assigns);
+        section(DECLARATIONS, program.declarations);
+        section(IFS, program.ifs);
+        section(WHILES, program.whiles);
+        section(FORS, program.fors);
+        section(BLOCKS, program.blocks);
+        section(CHILDREN, program.children);
+        section(TOKEN_LISTS, program.token_lists);
+        section(TOKENS, tokens);
+        section(STATEMENTS, program.statements);
+        section(PARAMETERS, program.parameters);
+        section(FUNCTIONS, program.functions);
+        section(FIELDS, program.fields);
+        section(CLASSES, program.classes);
+        section(PROTOCOLS, program.protocols);
+        section(EXPRESSION_STMTS, program.expression_stmts);
+      }
+
+      // The finished image, with the string table
+      std::string finish(uint64_t key) {
+        std::vector<uint32_t> string_offsets = offsets;
+        string_offsets.push_back(static_cast<uint32_t>(data.size()));
+        section(STRING_OFFSETS, string_offsets);
+        sections[STRING_DATA].count = data.size();
+        sections[STRING_DATA].bytes = data;
+
+        image_header header{};
+        std::memcpy(header.magic, image_magic, sizeof(image_magic));
+        header.version = image_version;
+        header.sections = static_cast<uint32_t>(sections.size());
+        header.key = key;
+
+        std::vector<section_entry> table(sections.size());
+        uint64_t offset = align(sizeof(image_header) + table.size() * sizeof(section_entry));
+        for (size_t i = 0; i < sections.size(); ++i) {
+          table[i] = { offset, sections[i].count };
+          offset = align(offset + sections[i].bytes.size());
+        }
+        header.size = offset;
+
+        std::string image(offset, '\0');
+        std::memcpy(image.data(), &header, sizeof(header));
+        std::memcpy(image.data() + sizeof(header), table.data(), table.size() * sizeof(section_entry));
+        for (size_t i = 0; i < sections.size(); ++i)
+          std::memcpy(image.data() + table[i].offset, sections[i].bytes.data(), sections[i].bytes.size());
+        return image;
+      }
+
+    private:
+      struct pending_section {
+        uint64_t count = 0;
+        std::string bytes;
+      };
+
+      std::vector<pending_section> sections;
+      std::unordered_map<std::string, uint32_t> strings;
+      std::vector<uint32_t> offsets;
+      std::string data;
+
+      static uint64_t align(uint64_t offset) { return (offset + 7) & ~uint64_t(7); }
+
+      packed_literal literal(const lexer::literal& value) {
+        packed_literal out{ static_cast<uint32_t>(value.index()), no_string, 0 };
+        if (auto* text = std::get_if<std::string>(&value)) out.text = string(*text);
+        if (auto* number = std::get_if<double>(&value)) out.number = *number;
+        if (auto* boolean = std::get_if<bool>(&value)) out.number = *boolean;
+        return out;
+      }
+    };
+
+    // Read-only view of an image; the bytes must outlive it and every view
+    // taken from it
+    struct image_reader {
+      // False if bytes is not a complete image of this version with this key
+      bool open(std::string_view bytes, uint64_t key, uint32_t sections) {
+        image_header header;
+        if (bytes.size() < sizeof(header) || reinterpret_cast<uintptr_t>(bytes.data()) % 8 != 0)
+          return false;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (std::memcmp(header.magic, image_magic, sizeof(image_magic)) != 0 || header.version != image_version ||
+          header.key != key || header.sections != sections || header.size != bytes.size() ||
+          sizeof(header) + sections * sizeof(section_entry) > bytes.size())
+          return false;
+
+        table = reinterpret_cast<const section_entry*>(bytes.data() + sizeof(header));
+        for (uint32_t i = 0; i < sections; ++i)
+          if (table[i].offset % 8 != 0 || table[i].offset > bytes.size() || table[i].count > bytes.size())
+            return false;
+        image = bytes;
+        return true;
+      }
+
+      // Section index as an array of T; empty if it does not fit in the image
+      template <class T>
+      array_view<T> section(uint32_t index) const {
+        const section_entry& entry = table[index];
+        if (entry.count * sizeof(T) > image.size() - entry.offset) return {};
+        return { reinterpret_cast<const T*>(image.data() + entry.offset), entry.count };
+      }
+
+    private:
+      std::string_view image;
+      const section_entry* table = nullptr;
+    };
+
+    // The flat_program stored in an image, turned back into pointer nodes
+    // one statement at a time
+    struct flat_image {
+      array_view<uint32_t> string_offsets;
+      array_view<char> string_data;
+      array_view<node_kind> kinds;
+      array_view<uint32_t> slots;
+      array_view<flat_program::binary_node> binaries;
+      array_view<flat_program::unary_node> unaries;
+      array_view<packed_literal> literals;
+      array_view<flat_program::var_node> vars;
+      array_view<flat_program::call_node> calls;
+      array_view<flat_program::new_node> news;
+      array_view<flat_program::let_node> lets;
+      array_view<flat_program::assign_node> assigns;
+      array_view<flat_program::declaration_node> declarations;
+      array_view<flat_program::if_node> ifs;
+      array_view<flat_program::while_node> whiles;
+      array_view<flat_program::for_node> fors;
+      array_view<node_range> blocks;
+      array_view<node_id> children;
+      array_view<uint32_t> token_lists;
+      array_view<packed_token> tokens;
+      array_view<flat_program::stmt_ref> statements;
+      array_view<flat_program::parameter_node> parameters;
+      array_view<flat_program::function_node> functions;
+      array_view<flat_program::field_node> fields;
+      array_view<flat_program::class_node> classes;
+      array_view<flat_program::protocol_node> protocols;
+      array_view<node_id> expression_stmts;
+
+      flat_image() = default;
+
+      explicit flat_image(const image_reader& in)
+        : string_offsets(in.section<uint32_t>(STRING_OFFSETS)),
+        string_data(in.section<char>(STRING_DATA)),
+        kinds(in.section<node_kind>(KINDS)),
+        slots(in.section<uint32_t>(SLOTS)),
+        binaries(in.section<flat_program::binary_node>(BINARIES)),
+        unaries(in.section<flat_program::unary_node>(UNARIES)),
+        literals(in.section<packed_literal>(LITERALS)),
+        vars(in.section<flat_program::var_node>(VARS)),
+        calls(in.section<flat_program::call_node>(CALLS)),
+        news(in.section<flat_program::new_node>(NEWS)),
+        lets(in.section<flat_program::let_node>(LETS)),
+        assigns(in.section<flat_program::assign_node>(ASSIGNS)),
+        declarations(in.section<flat_program::declaration_node>(DECLARATIONS)),
+        ifs(in.section<flat_program::if_node>(IFS)),
+        whiles(in.section<flat_program::while_node>(WHILES)),
+        fors(in.section<flat_program::for_node>(FORS)),
+        blocks(in.section<node_range>(BLOCKS)),
+        children(in.section<node_id>(CHILDREN)),
+        token_lists(in.section<uint32_t>(TOKEN_LISTS)),
+        tokens(in.section<packed_token>(TOKENS)),
+        statements(in.section<flat_program::stmt_ref>(STATEMENTS)),
+        parameters(in.section<flat_program::parameter_node>(PARAMETERS)),
+        functions(in.section<flat_program::function_node>(FUNCTIONS)),
+        fields(in.section<flat_program::field_node>(FIELDS)),
+        classes(in.section<flat_program::class_node>(CLASSES)),
+        protocols(in.section<flat_program::protocol_node>(PROTOCOLS)),
+        expression_stmts(in.section<node_id>(EXPRESSION_STMTS)) {
+      }
+
+      // Every index in the image is inside its section and every expression
+      // only refers to nodes written before it (flattener writes children
+      // first), so statement() reads nothing outside the image and ends.
+      // Checked once when the image is opened: a file damaged on disk can
+      // have a good header and still point anywhere.
+      bool valid() const;
+
+      bool has_string(uint32_t id) const {
+        return string_offsets.size() > 0 && id < string_offsets.size() - 1;
+      }
+
+      std::string_view string(uint32_t id) const {
+        return { string_data.items + string_offsets[id], string_offsets[id + 1] - string_offsets[id] };
+      }
+
+      lexer::literal literal(const packed_literal& value) const {
+        switch (value.kind) {
+          case 1: return std::string(string(value.text));
+          case 2: return value.number;
+          case 3: return value.number != 0;
+          default: return nullptr;
+        }
+      }
+
+      // The lexeme is interned, so the token does not point into the image
+      lexer::token token(uint32_t index) const {
+        const packed_token& t = tokens[index];
+        lexer::literal value = t.value == no_string ? lexer::literal(nullptr) : literal(literals[t.value]);
+        lexer::token out(static_cast<lexer::token_type>(t.type), "", value, t.line, t.column);
+        out.set_lexeme(string(t.lexeme));
+        if (!t.has_id) out.id = lexer::empty_symbol;
+        return out;
+      }
+
+      // Statement index of the image, built in arena
+      stmt_ptr statement(size_t index, ast_arena& arena) const;
+    };
+
+    // Inverse of flattener
+    struct unflattener {
+      const flat_image& in;
+      ast_arena& arena;
+
+      std::optional<expr_ptr> optional(node_id id) {
+        if (id == no_node) return std::nullopt;
+        return expression(id);
+      }
+
+      std::vector<expr_ptr> list(node_range range) {
+        std::vector<expr_ptr> exprs;
+        for (uint32_t i = 0; i < range.count; ++i) exprs.push_back(expression(in.children[range.first + i]));
+        return exprs;
+      }
+
+      expr_ptr expression(node_id id) {
+        if (id == no_node) return nullptr;
+        if (internal::stack_exhausted())
+          return internal::grow_stack([&] { return expression(id); });
+
+        const uint32_t slot = in.slots[id];
+        switch (in.kinds[id]) {
+          case node_kind::BINARY: {
+            const auto& n = in.binaries[slot];
+            expr_ptr left = expression(n.left);
+            return arena.make<binary_expr>(left, in.token(n.token), n.op, expression(n.right));
+          }
+          case node_kind::UNARY: {
+            const auto& n = in.unaries[slot];
+            return arena.make<unary_expr>(in.token(n.token), n.op, expression(n.expression));
+          }
+          case node_kind::LITERAL:
+            return arena.make<literal_expr>(in.literal(in.literals[slot]));
+          case node_kind::VAR: {
+            const auto& n = in.vars[slot];
+            return arena.make<var_expr>(optional(n.object), in.token(n.name));
+          }
+          case node_kind::CALL: {
+            const auto& n = in.calls[slot];
+            std::optional<expr_ptr> object = optional(n.object);
+            return arena.make<call_expr>(object, in.token(n.callee), list(n.arguments));
+          }
+          case node_kind::NEW: {
+            const auto& n = in.news[slot];
+            return arena.make<new_expr>(in.token(n.type_name), list(n.arguments));
+          }
+          case node_kind::BLOCK:
+            return arena.make<block_expr>(list(in.blocks[slot]));
+          case node_kind::LET: {
+            const auto& n = in.lets[slot];
+            std::vector<declaration_expr_ptr> assignments;
+            for (uint32_t i = 0; i < n.assignments.count; ++i)
+              assignments.push_back(static_cast<declaration_expr_ptr>(expression(in.children[n.assignments.first + i])));
+            return arena.make<let_expr>(std::move(assignments), expression(n.body));
+          }
+          case node_kind::ASSIGN: {
+            const auto& n = in.assigns[slot];
+            expr_ptr variable = expression(n.variable);
+            return arena.make<assign_expr>(variable, in.token(n.type), expression(n.value));
+          }
+          case node_kind::DECLARATION: {
+            const auto& n = in.declarations[slot];
+            return arena.make<declaration_expr>(in.token(n.name), in.token(n.type), expression(n.value));
+          }
+          case node_kind::IF: {
+            const auto& n = in.ifs[slot];
+            expr_ptr condition = expression(n.condition), then_branch = expression(n.then_branch);
+            std::vector<std::pair<expr_ptr, expr_ptr>> elifs;
+            for (uint32_t i = 0; i < n.elifs.count; i += 2) {
+              expr_ptr c = expression(in.children[n.elifs.first + i]);
+              elifs.emplace_back(c, expression(in.children[n.elifs.first + i + 1]));
+            }
+            std::vector<lexer::token> elif_tokens;
+            for (uint32_t i = 0; i < n.elif_tokens.count; ++i)
+              elif_tokens.push_back(in.token(in.token_lists[n.elif_tokens.first + i]));
+            return arena.make<if_expr>(in.token(n.condition_token), condition, then_branch, std::move(elif_tokens),
+              std::move(elifs), optional(n.else_branch));
+          }
+          case node_kind::WHILE: {
+            const auto& n = in.whiles[slot];
+            expr_ptr condition = expression(n.condition);
+            return arena.make<while_expr>(in.token(n.condition_token), condition, expression(n.body));
+          }
+          case node_kind::FOR: {
+            const auto& n = in.fors[slot];
+            expr_ptr iterable = expression(n.iterable);
+            return arena.make<for_expr>(in.token(n.var_name), in.token(n.var_type), iterable, expression(n.body));
+          }
+        }
+        return nullptr;
+      }
+
+      std::vector<parameter> parameters(node_range range) {
+        std::vector<parameter> params;
+        for (uint32_t i = 0; i < range.count; ++i) {
+          const auto& p = in.parameters[range.first + i];
+          params.emplace_back(in.token(p.name), in.token(p.type));
+        }
+        return params;
+      }
+
+      function_stmt_ptr function(uint32_t slot) {
+        const auto& f = in.functions[slot];
+        return arena.make<function_stmt>(in.token(f.name), f.type, parameters(f.parameters), expression(f.body),
+          in.token(f.return_type));
+      }
+
+      std::vector<function_stmt_ptr> functions(node_range range) {
+        std::vector<function_stmt_ptr> fns;
+        for (uint32_t i = 0; i < range.count; ++i) fns.push_back(function(range.first + i));
+        return fns;
+      }
+
+      stmt_ptr statement(const flat_program::stmt_ref& s) {
+        using kind = flat_program::stmt_kind;
+
+        switch (s.kind) {
+          case kind::FUNCTION:
+            return function(s.slot);
+          case kind::CLASS: {
+            const auto& c = in.classes[s.slot];
+            std::optional<super_item_ptr> super_class;
+            if (c.has_super) super_class = arena.make<super_item>(in.token(c.super_name), list(c.super_init));
+            std::vector<field_stmt_ptr> fields;
+            for (uint32_t i = 0; i < c.fields.count; ++i) {
+              const auto& f = in.fields[c.fields.first + i];
+              fields.push_back(arena.make<field_stmt>(in.token(f.name), in.token(f.type), expression(f.initializer)));
+            }
+            return arena.make<class_stmt>(in.token(c.name), parameters(c.parameters), super_class, std::move(fields),
+              functions(c.methods));
+          }
+          case kind::PROTOCOL: {
+            const auto& p = in.protocols[s.slot];
+            return arena.make<protocol_stmt>(in.token(p.name), functions(p.methods), in.token(p.super_protocol));
+          }
+          case kind::EXPRESSION:
+            return arena.make<expression_stmt>(expression(in.expression_stmts[s.slot]));
+        }
+        return nullptr;
+      }
+    };
+
+    bool flat_image::valid() const {
+      if (string_offsets.size() == 0) return false;
+      for (size_t i = 0; i < string_offsets.size(); ++i)
+        if (string_offsets[i] > string_data.size() || (i > 0 && string_offsets[i] < string_offsets[i - 1])) return false;
+
+      for (const auto& l : literals)
+        if (l.kind > 3 || (l.kind == 1 && !has_string(l.text))) return false;
+      for (const auto& t : tokens)
+        if (t.type > lexer::UNKNOWN || !has_string(t.lexeme) || (t.value != no_string && t.value >= literals.size()))
+          return false;
+      for (uint32_t t : token_lists)
+        if (t >= tokens.size()) return false;
+
+      auto token = [&](uint32_t t) { return t < tokens.size(); };
+      // a child of node id (no_node stands for a missing one)
+      auto child = [&](node_id c, node_id id) { return c == no_node || c < id; };
+      auto children_of = [&](node_range range, node_id id) {
+        if (!in_bounds(range, children.size())) return false;
+        for (uint32_t i = 0; i < range.count; ++i)
+          if (!child(children[range.first + i], id)) return false;
+        return true;
+      };
+
+      if (slots.size() != kinds.size()) return false;
+      for (node_id id = 0; id < kinds.size(); ++id) {
+        const uint32_t slot = slots[id];
+        switch (kinds[id]) {
+          case node_kind::BINARY: {
+            if (slot >= binaries.size()) return false;
+            const auto& n = binaries[slot];
+            if (!child(n.left, id) || !child(n.right, id) || !token(n.token)) return false;
+            break;
+          }
+          case node_kind::UNARY: {
+            if (slot >= unaries.size()) return false;
+            const auto& n = unaries[slot];
+            if (!child(n.expression, id) || !token(n.token)) return false;
+            break;
+          }
+          case node_kind::LITERAL:
+            if (slot >= literals.size()) return false;
+            break;
+          case node_kind::VAR: {
+            if (slot >= vars.size()) return false;
+            const auto& n = vars[slot];
+            if (!child(n.object, id) || !token(n.name)) return false;
+            break;
+          }
+          case node_kind::CALL: {
+            if (slot >= calls.size()) return false;
+            const auto& n = calls[slot];
+            if (!child(n.object, id) || !token(n.callee) || !children_of(n.arguments, id)) return false;
+            break;
+          }
+          case node_kind::NEW: {
+            if (slot >= news.size()) return false;
+            const auto& n = news[slot];
+            if (!token(n.type_name) || !children_of(n.arguments, id)) return false;
+            break;
+          }
+          case node_kind::BLOCK:
+            if (slot >= blocks.size() || !children_of(blocks[slot], id)) return false;
+            break;
+          case node_kind::LET: {
+            if (slot >= lets.size()) return false;
+            const auto& n = lets[slot];
+            if (!children_of(n.assignments, id) || !child(n.body, id)) return false;
+            for (uint32_t i = 0; i < n.assignments.count; ++i) {
+              node_id a = children[n.assignments.first + i];
+              if (a != no_node && kinds[a] != node_kind::DECLARATION) return false;
+            }
+            break;
+          }
+          case node_kind::ASSIGN: {
+            if (slot >= assigns.size()) return false;
+            const auto& n = assigns[slot];
+            if (!child(n.variable, id) || !child(n.value, id) || !token(n.type)) return false;
+            break;
+          }
+          case node_kind::DECLARATION: {
+            if (slot >= declarations.size()) return false;
+            const auto& n = declarations[slot];
+            if (!token(n.name) || !token(n.type) || !child(n.value, id)) return false;
+            break;
+          }
+          case node_kind::IF: {
+            if (slot >= ifs.size()) return false;
+            const auto& n = ifs[slot];
+            if (!token(n.condition_token) || !child(n.condition, id) || !child(n.then_branch, id) ||
+              n.elifs.count % 2 != 0 || !children_of(n.elifs, id) || !in_bounds(n.elif_tokens, token_lists.size()) ||
+              !child(n.else_branch, id))
+              return false;
+            break;
+          }
+          case node_kind::WHILE: {
+            if (slot >= whiles.size()) return false;
+            const auto& n = whiles[slot];
+            if (!token(n.condition_token) || !child(n.condition, id) || !child(n.body, id)) return false;
+            break;
+          }
+          case node_kind::FOR: {
+            if (slot >= fors.size()) return false;
+            const auto& n = fors[slot];
+            if (!token(n.var_name) || !token(n.var_type) || !child(n.iterable, id) || !child(n.body, id)) return false;
+            break;
+          }
+          default:
+            return false;
+        }
+      }
+
+      // statements can refer to any node
+      const node_id end = static_cast<node_id>(kinds.size());
+      auto parameters_in = [&](node_range range) {
+        if (!in_bounds(range, parameters.size())) return false;
+        for (uint32_t i = 0; i < range.count; ++i)
+          if (!token(parameters[range.first + i].name) || !token(parameters[range.first + i].type)) return false;
+        return true;
+      };
+      for (const auto& f : functions)
+        if (!token(f.name) || f.type > function_type::METHOD || !parameters_in(f.parameters) || !child(f.body, end) ||
+          !token(f.return_type))
+          return false;
+      for (const auto& f : fields)
+        if (!token(f.name) || !token(f.type) || !child(f.initializer, end)) return false;
+      for (const auto& c : classes) {
+        uint8_t has_super;
+        std::memcpy(&has_super, &c.has_super, 1);
+        if (!token(c.name) || !parameters_in(c.parameters) || has_super > 1 || (has_super && !token(c.super_name)) ||
+          !children_of(c.super_init, end) || !in_bounds(c.fields, fields.size()) || !in_bounds(c.methods, functions.size()))
+          return false;
+      }
+      for (const auto& p : protocols)
+        if (!token(p.name) || !in_bounds(p.methods, functions.size()) || !token(p.super_protocol)) return false;
+      for (node_id e : expression_stmts)
+        if (!child(e, end)) return false;
+
+      using kind = flat_program::stmt_kind;
+      for (const auto& s : statements) {
+        switch (s.kind) {
+          case kind::FUNCTION: if (s.slot >= functions.size()) return false; break;
+          case kind::CLASS: if (s.slot >= classes.size()) return false; break;
+          case kind::PROTOCOL: if (s.slot >= protocols.size()) return false; break;
+          case kind::EXPRESSION: if (s.slot >= expression_stmts.size()) return false; break;
+          default: return false;
+        }
+      }
+      return true;
+    }
+
+    stmt_ptr flat_image::statement(size_t index, ast_arena& arena) const {
+      unflattener builder{ *this, arena };
+      return builder.statement(statements[index]);
+    }
+
+  }  // namespace ast
+}  // namespace hulk
+
+#endif  // HULK_AST_SERIALIZE_HPP
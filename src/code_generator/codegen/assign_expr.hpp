@@ -8,6 +8,9 @@ namespace hulk {
     namespace ast {
 
         llvm::Value* assign_expr::codegen() {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return codegen(); });
+
             llvm::Value* value_obj = value->codegen();
             if (!value_obj) {
                 llvm::errs() << "Error: Failed to generate code for value in assignment.\n";
@@ -15,7 +18,7 @@ namespace hulk {
                 return nullptr;
             }
 
-            var_expr* var = dynamic_cast<var_expr*>(variable.get());
+            var_expr* var = dynamic_cast<var_expr*>(variable);
             if (!var) {
                 llvm::errs() << "Error: Variable in assignment is not a var_expr.\n";
                 internal::error_found = true;
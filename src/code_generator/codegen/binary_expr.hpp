@@ -98,6 +98,9 @@ namespace hulk {
         }
 
         llvm::Value* binary_expr::codegen() {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return codegen(); });
+
             llvm::Value* L = left->codegen();
             llvm::Value* R = right->codegen();
 
@@ -13,6 +13,9 @@ namespace hulk {
     namespace ast {
 
       llvm::Value* block_expr::codegen() {
+        if (internal::stack_exhausted())
+          return internal::grow_stack([&] { return codegen(); });
+
         llvm::Value* last_value = nullptr;
         for (const auto &expr: expressions) {
           last_value = expr->codegen();
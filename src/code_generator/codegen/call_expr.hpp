@@ -9,6 +9,9 @@ namespace hulk {
 namespace ast {
 
 llvm::Value* call_expr::codegen() {
+  if (internal::stack_exhausted())
+    return internal::grow_stack([&] { return codegen(); });
+
   // Special case for print
   if (callee.lexeme == "print") {
     if (arguments.size() != 1) {
@@ -66,7 +69,7 @@ llvm::Value* call_expr::codegen() {
     return RetValue;
   }
 
-  llvm::Function* CalleF = TheModule->getFunction(callee.lexeme);
+  llvm::Function* CalleF = TheModule->getFunction(callee.get_lexeme());
 
   std::vector<llvm::Value*> argsValues;
   for (auto i = 0; i < arguments.size(); i++) {
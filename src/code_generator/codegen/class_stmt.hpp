@@ -32,7 +32,7 @@ namespace hulk {
                 // Create an alloca for this variable.
                 llvm::AllocaInst* alloca = CreateEntryBlockAlloca(func, arg.getType(), std::string(arg.getName()));
                 Builder->CreateStore(&arg, alloca);
-                NamedValues[std::string(arg.getName())] = alloca;
+                NamedValues[lexer::intern(arg.getName().str())] = alloca;
             }
 
             llvm::Value* ret_val = method->body->codegen();
@@ -52,7 +52,7 @@ namespace hulk {
 
         llvm::GlobalVariable* create_vtable(const class_stmt* type_ptr, llvm::StructType* class_type) {
             std::string type_name = type_ptr->name.get_lexeme();
-            std::string parent_name = type_ptr->super_class->get()->name.get_lexeme();
+            std::string parent_name = (*type_ptr->super_class)->name.get_lexeme();
 
             // Registrar todos los métodos primero
             for (const auto& method : type_ptr->methods) {
@@ -123,17 +123,17 @@ namespace hulk {
                 // Create an alloca for this variable.
                 llvm::AllocaInst* alloca = CreateEntryBlockAlloca(ctor_func, arg.getType(), std::string(arg.getName()));
                 Builder->CreateStore(&arg, alloca);
-                NamedValues[std::string(arg.getName())] = alloca;
+                NamedValues[lexer::intern(arg.getName().str())] = alloca;
             }
 
             llvm::Value* instance = Builder->CreateAlloca(class_type, nullptr, type_name + "_inst");
 
             // Call parent constructor
-            auto parent_type_str = type_ptr->super_class->get()->name.lexeme;
+            auto parent_type_str = (*type_ptr->super_class)->name.get_lexeme();
             auto* parent_ctor = TheModule->getFunction(parent_type_str + "._ctor");
 
             std::vector<llvm::Value*> parent_args;
-            for (const auto& arg : type_ptr->super_class->get()->init) {
+            for (const auto& arg : (*type_ptr->super_class)->init) {
                 auto* arg_value = arg->codegen();
                 parent_args.push_back(arg_value);
             }
@@ -187,13 +187,13 @@ namespace hulk {
             std::vector<llvm::Type*> field_types;
 
             // Add parent type fields at the beginning
-            llvm::Type* super_type_ptr = GetType(super_class->get()->name.get_lexeme(), TheModule.get())->getPointerTo();
+            llvm::Type* super_type_ptr = GetType((*super_class)->name.get_lexeme(), TheModule.get())->getPointerTo();
             field_types.push_back(super_type_ptr);
 
             for (const auto& field : fields) {
                 llvm::Type* field_type = GetType(field->type.get_lexeme(), TheModule.get());
                 field_types.push_back(field_type);
-                AddStructField(type_name, field->name.lexeme);
+                AddStructField(type_name, field->name.get_lexeme());
             }
 
             class_type->setBody(field_types);
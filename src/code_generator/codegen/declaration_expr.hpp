@@ -8,6 +8,9 @@ namespace hulk {
     namespace ast {
 
         llvm::Value* declaration_expr::codegen() {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return codegen(); });
+
             llvm::Value* init_val = value->codegen();
             if (!init_val) return nullptr;
 
@@ -17,7 +20,7 @@ namespace hulk {
 
             Builder->CreateStore(init_val, alloca);
 
-            NamedValues[name.get_lexeme()] = alloca;
+            NamedValues[name.id] = alloca;
 
             return init_val;
         }
@@ -11,17 +11,17 @@ namespace hulk {
             // Create FunctionType
             std::vector<llvm::Type*> ParamTypes;
             for (const auto& param : parameters)
-                ParamTypes.push_back(GetType(param.type.lexeme, TheModule.get()));
+                ParamTypes.push_back(GetType(param.type.get_lexeme(), TheModule.get()));
 
-            llvm::FunctionType* FuncType = llvm::FunctionType::get(GetType(return_type.lexeme, TheModule.get()), ParamTypes, false);
+            llvm::FunctionType* FuncType = llvm::FunctionType::get(GetType(return_type.get_lexeme(), TheModule.get()), ParamTypes, false);
 
             // Create Function
-            llvm::Function* Func = llvm::Function::Create(FuncType, llvm::Function::ExternalLinkage, name.lexeme, TheModule.get());
+            llvm::Function* Func = llvm::Function::Create(FuncType, llvm::Function::ExternalLinkage, name.get_lexeme(), TheModule.get());
 
             // Get parameters
             int idx = 0;
             for (auto& Arg : Func->args()) {
-                Arg.setName(parameters[idx].name.lexeme);
+                Arg.setName(parameters[idx].name.get_lexeme());
                 idx++;
             }
 
@@ -39,7 +39,7 @@ namespace hulk {
                 Builder->CreateStore(&Arg, Alloca);
 
                 // Add arguments to variable symbol table.
-                NamedValues[std::string(Arg.getName())] = Alloca;
+                NamedValues[lexer::intern(Arg.getName().str())] = Alloca;
             }
 
             // Get return value
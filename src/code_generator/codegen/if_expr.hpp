@@ -13,6 +13,9 @@ namespace hulk {
     namespace ast {
 
         llvm::Value* if_expr::codegen() {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return codegen(); });
+
             llvm::Value* condition_value = condition->codegen();
             llvm::Value* condition_bool = Builder->CreateICmpNE(
                 condition_value,
@@ -7,10 +7,13 @@ namespace hulk {
     namespace ast {
 
         llvm::Value* let_expr::codegen() {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return codegen(); });
+
             std::vector<llvm::AllocaInst*> old_bindings;
 
             for (const auto& decl : assignments) {
-                old_bindings.push_back(NamedValues[decl->name.get_lexeme()]);
+                old_bindings.push_back(NamedValues[decl->name.id]);
                 decl->codegen();
             }
 
@@ -18,7 +21,7 @@ namespace hulk {
 
             int idx = 0;
             for (const auto& decl : assignments)
-                NamedValues[decl->name.get_lexeme()] = old_bindings[idx++];
+                NamedValues[decl->name.id] = old_bindings[idx++];
 
             return body_value;
         }
@@ -7,6 +7,9 @@ namespace hulk {
     namespace ast {
 
         llvm::Value* new_expr::codegen() {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return codegen(); });
+
             std::string struct_name = "type." + type_name.get_lexeme();
 
             llvm::StructType* struct_type = llvm::StructType::getTypeByName(*TheContext, struct_name);
@@ -7,6 +7,9 @@ namespace hulk {
     namespace ast {
         
         llvm::Value* unary_expr::codegen() {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return codegen(); });
+
             llvm::Value* V = expression->codegen();
 
             if (!V)  {
@@ -104,7 +104,7 @@ namespace hulk {
             }
 
             if (var->object) {
-                var_expr* object_var = dynamic_cast<var_expr*>(var->object->get());
+                var_expr* object_var = dynamic_cast<var_expr*>(*var->object);
                 if (!object_var) {
                     llvm::errs() << "Error: Object in variable is not a var_expr.\n";
                     internal::error_found = true;
@@ -145,7 +145,7 @@ namespace hulk {
                 return member_ptr;
             }
             else {
-                auto it = NamedValues.find(var->name.get_lexeme());
+                auto it = NamedValues.find(var->name.id);
                 if (it == NamedValues.end()) {
                     llvm::errs() << "Error: Variable '" << var->name.get_lexeme() << "' not found.\n";
                     internal::error_found = true;
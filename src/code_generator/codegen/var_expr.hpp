@@ -8,6 +8,9 @@ namespace hulk {
     namespace ast {
 
         llvm::Value* var_expr::codegen() {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return codegen(); });
+
             if (object.has_value()) {
                 llvm::Value* object_value = (*object)->codegen();
 
@@ -33,7 +36,7 @@ namespace hulk {
                 return Builder->CreateLoad(object_type->getStructElementType(index), member_ptr, name.get_lexeme());
             }
             else {
-                llvm::AllocaInst* alloca = NamedValues[name.get_lexeme()];
+                llvm::AllocaInst* alloca = NamedValues[name.id];
 
                 if (!alloca) {
                     llvm::errs() << "Error in var_expr codegen: " << name.get_lexeme() << "\n";
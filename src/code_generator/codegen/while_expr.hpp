@@ -11,6 +11,9 @@ namespace hulk {
 namespace ast {
 
 llvm::Value* while_expr::codegen() {
+    if (internal::stack_exhausted())
+        return internal::grow_stack([&] { return codegen(); });
+
     llvm::BasicBlock* curBB = Builder->GetInsertBlock();
     llvm::Function* TheFunction = curBB->getParent();
 
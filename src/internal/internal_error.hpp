@@ -12,14 +12,42 @@ namespace hulk {
     static bool error_found = false;
     static unsigned int lib_lines = 0;
 
-    static void print(const unsigned int line, const unsigned int column, const std::string where, const std::string message, std::string component = "") {
-      std::cerr << "[" << line << ", " << column << "] error in " << component << where << ": " << message << "\n";
+    // Si apunta a algo, los errores de este hilo solo se anotan ahi (no se
+    // imprimen ni tocan error_found); lo usan los hilos de parse_parallel
+    static thread_local bool* silenced_errors = nullptr;
+
+    // Se imprimen a lo sumo max_errors errores; despues de un aviso el resto
+    // solo marca error_found (casi siempre son consecuencia de los primeros)
+    // y las fases que pueden cortar antes lo miran con too_many_errors
+    constexpr unsigned int max_errors = 100;
+    static unsigned int errors_reported = 0;
+
+    static bool too_many_errors() { return errors_reported > max_errors; }
+
+    // true si el error se tiene que imprimir
+    static bool count_error() {
       error_found = true;
+      if (++errors_reported <= max_errors) return true;
+      if (errors_reported == max_errors + 1) std::cerr << "Too many errors, the rest are not shown.\n";
+      return false;
+    }
+
+    static void print(const unsigned int line, const unsigned int column, const std::string where, const std::string message, std::string component = "") {
+      if (silenced_errors) {
+        *silenced_errors = true;
+        return;
+      }
+      if (count_error())
+        std::cerr << "[" << line << ", " << column << "] error in " << component << where << ": " << message << "\n";
     }
 
     static void error(const std::string message, const std::string component = "") {
-      std::cerr << "Internal Error: " << component << " " << message << "\n";
-      error_found = true;
+      if (silenced_errors) {
+        *silenced_errors = true;
+        return;
+      }
+      if (count_error())
+        std::cerr << "Internal Error: " << component << " " << message << "\n";
     }
 
     static void error(const unsigned int line, const unsigned int column, const std::string message) {
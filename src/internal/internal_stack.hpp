@@ -0,0 +1,155 @@
+#ifndef HULK_INTERNAL_STACK_HPP
+#define HULK_INTERNAL_STACK_HPP 1
+
+#include <pthread.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hulk {
+
+namespace internal {
+
+// Pila segmentada para los recorridos recursivos del AST (parser, pasadas
+// semanticas, codegen). Cada funcion recursiva empieza con
+//
+//   if (internal::stack_exhausted())
+//     return internal::grow_stack([&] { return <la misma llamada>; });
+//
+// Mientras quede pila no pasa nada mas que una comparacion. Cuando se acaba
+// la llamada sigue en un segmento nuevo de stack_segment_size bytes y al
+// volver se retoma la pila anterior, asi la profundidad del programa solo
+// esta limitada por la memoria y el codigo de cada pasada queda igual.
+constexpr size_t stack_segment_size = size_t(256) << 20;
+
+// margen que se deja en cada segmento: tiene que alcanzar para lo que se
+// use entre dos chequeos (unos pocos frames y lo que llamen por fuera)
+constexpr size_t stack_red_zone = size_t(1) << 20;
+
+namespace stack_detail {
+
+struct segment {
+  void *memory = nullptr;
+};
+
+// segmentos de este hilo, uno por nivel de anidamiento; se reusan para no
+// pedir y devolver memoria cada vez que un recorrido cruza el borde
+struct segments {
+  std::vector<segment> pool;
+  size_t depth = 0;
+  const char *limit = nullptr;
+
+  ~segments() {
+    for (auto &s : pool) munmap(s.memory, stack_segment_size);
+  }
+};
+
+inline thread_local segments state;
+
+// limite de la pila del hilo, se calcula la primera vez
+inline const char *thread_limit() {
+  pthread_attr_t attr;
+  void *address = nullptr;
+  size_t size = 0;
+  if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+    pthread_attr_getstack(&attr, &address, &size);
+    pthread_attr_destroy(&attr);
+  }
+  if (!address || size <= 2 * stack_red_zone) {
+    // sin datos se asume la pila de 8 MB por defecto desde aca
+    const char *here = static_cast<const char *>(__builtin_frame_address(0));
+    return here - (size_t(8) << 20) + stack_red_zone;
+  }
+  return static_cast<const char *>(address) + stack_red_zone;
+}
+
+struct call {
+  void (*run)(void *);
+  void *argument;
+  std::exception_ptr error;
+};
+
+inline thread_local call *pending = nullptr;
+
+inline void trampoline() {
+  call *c = pending;
+  try {
+    c->run(c->argument);
+  } catch (...) {
+    // las excepciones no pueden cruzar de un segmento a otro
+    c->error = std::current_exception();
+  }
+}
+
+// corre c en el siguiente segmento y vuelve cuando termina
+inline void switch_and_run(call &c) {
+  segments &s = state;
+  if (s.depth == s.pool.size()) {
+    void *memory = mmap(nullptr, stack_segment_size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK,
+                        -1, 0);
+    if (memory == MAP_FAILED) abort();
+    s.pool.push_back({memory});
+  }
+  char *memory = static_cast<char *>(s.pool[s.depth].memory);
+
+  ucontext_t caller, callee;
+  getcontext(&callee);
+  callee.uc_stack.ss_sp = memory;
+  callee.uc_stack.ss_size = stack_segment_size;
+  callee.uc_link = &caller;
+  makecontext(&callee, trampoline, 0);
+
+  const char *previous_limit = s.limit;
+  s.limit = memory + stack_red_zone;
+  ++s.depth;
+  pending = &c;
+  swapcontext(&caller, &callee);
+  --s.depth;
+  s.limit = previous_limit;
+
+  if (c.error) std::rethrow_exception(c.error);
+}
+
+}  // namespace stack_detail
+
+// true si queda menos de stack_red_zone en el segmento actual
+inline bool stack_exhausted() {
+  stack_detail::segments &s = stack_detail::state;
+  if (!s.limit) s.limit = stack_detail::thread_limit();
+  return static_cast<const char *>(__builtin_frame_address(0)) < s.limit;
+}
+
+// llama a f en un segmento nuevo de pila y devuelve lo que devuelva
+template <class F>
+auto grow_stack(F &&f) -> decltype(f()) {
+  using result_t = decltype(f());
+  using function_t = std::remove_reference_t<F>;
+  if constexpr (std::is_void_v<result_t>) {
+    stack_detail::call c{[](void *fn) { (*static_cast<function_t *>(fn))(); }, &f, {}};
+    stack_detail::switch_and_run(c);
+  } else {
+    std::pair<function_t *, std::optional<result_t>> data{&f, std::nullopt};
+    stack_detail::call c{
+        [](void *p) {
+          auto *d = static_cast<std::pair<function_t *, std::optional<result_t>> *>(p);
+          d->second.emplace((*d->first)());
+        },
+        &data, {}};
+    stack_detail::switch_and_run(c);
+    return std::move(*data.second);
+  }
+}
+
+}  // namespace internal
+
+}  // namespace hulk
+
+#endif  // HULK_INTERNAL_STACK_HPP
@@ -1,6 +1,9 @@
 #ifndef HULK_INTERNAL_UTIL_HPP
 #define HULK_INTERNAL_UTIL_HPP 1
 
+#include <cstdint>
+#include <string_view>
+
 namespace hulk {
 
 namespace internal {
@@ -10,6 +13,16 @@ container_t to(range_t &&range) {
   return container_t(begin(range), end(range));
 }
 
+// Hash FNV-1a de 64 bits de un texto, para saber si un archivo cambio
+inline uint64_t content_hash(std::string_view text) {
+  uint64_t hash = 14695981039346656037ull;
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
 }  // namespace internal
 
 }  // namespace hulk
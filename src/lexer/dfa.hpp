@@ -0,0 +1,282 @@
+#ifndef HULK_DFA_HPP
+#define HULK_DFA_HPP 1
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "regex_engine.hpp"
+#include "tokens.hpp"
+
+namespace hulk {
+
+namespace lexer {
+
+/*  Automata finito determinista para todos los tokens de Hulk
+    Se construye una sola vez a partir de regexs_tokens:
+        1. se unen todos los NFA de Thompson con un nuevo estado inicial,
+        2. construccion de subconjuntos (NFA -> DFA),
+        3. minimizacion de Hopcroft.
+    Cada estado de aceptacion queda etiquetado con el token_type de mayor
+    prioridad (el primero en regexs_tokens), asi el lexer hace maximal munch
+    en una sola pasada.
+    Al final los 256 bytes se agrupan en clases de equivalencia y el DFA se
+    guarda como una tabla plana de uint16_t (dfa_table) que cabe en la cache.
+    Todo esto lo hace dfa_generator.cpp al compilar, que escribe las tablas en
+    dfa_tables.hpp; el lexer solo las lee a traves de un dfa_view.
+*/
+
+// ======================== Estructura del DFA
+// ======================================
+
+struct dfa {
+  static constexpr int dead = 0;  // estado muerto: ya no se puede aceptar nada
+
+  std::vector<std::array<int, 256>> next;  // next[estado][byte]
+  std::vector<token_type> accept;          // UNKNOWN si no es de aceptacion
+  int start = dead;
+
+  int size() const { return static_cast<int>(next.size()); }
+};
+
+// DFA compacto: next[estado * classes + byte_class[byte]]
+struct dfa_table {
+  std::array<uint8_t, 256> byte_class;  // byte -> clase de equivalencia
+  uint16_t classes = 0;
+  uint16_t start = 0;
+  std::vector<uint16_t> next;
+  std::vector<token_type> accept;  // UNKNOWN si no es de aceptacion
+};
+
+// Vista sobre las tablas de un dfa_table, es lo que usa el lexer y se puede
+// construir en tiempo de compilacion sobre las tablas generadas
+struct dfa_view {
+  static constexpr uint16_t dead = 0;
+
+  const uint8_t *byte_class;
+  uint16_t classes;
+  uint16_t start;
+  const uint16_t *next;
+  const token_type *accept;
+
+  constexpr uint16_t step(uint16_t s, unsigned char c) const {
+    return next[s * classes + byte_class[c]];
+  }
+};
+
+// ======================== Construccion de subconjuntos
+// ======================================
+
+// Devuelve el token_type de mayor prioridad entre los estados de aceptacion
+// del conjunto (UNKNOWN si no hay ninguno)
+token_type subset_accept(const std::set<uint32_t> &states,
+                         const std::vector<size_t> &priority,
+                         const std::vector<token_type> &types) {
+  size_t best = types.size();
+  for (auto s : states)
+    if (priority[s] < best) best = priority[s];
+  return best < types.size() ? types[best] : token_type::UNKNOWN;
+}
+
+// DFA sin minimizar: el estado 0 es el conjunto vacio (estado muerto)
+dfa subset_construction(
+    const std::vector<std::pair<std::string, token_type>> &table) {
+  nfa_arena arena;
+  std::vector<token_type> types;
+  uint32_t start = arena.new_state();
+  std::vector<nfa> nfas;
+
+  for (size_t i = 0; i < table.size(); ++i) {
+    parser p(table[i].first, arena);
+    nfas.push_back(p.parse());
+    arena[start].out.push_back({transition_type::EPSILON, 0, nfas.back().start});
+    types.push_back(table[i].second);
+  }
+
+  // estado final -> indice en la tabla (table.size() si no es final)
+  std::vector<size_t> priority(arena.size(), table.size());
+  for (size_t i = 0; i < nfas.size(); ++i) priority[nfas[i].accept] = i;
+
+  std::vector<std::set<uint32_t>> subsets;
+  std::map<std::set<uint32_t>, int> ids;
+  dfa result;
+
+  auto get_id = [&](const std::set<uint32_t> &s) {
+    auto it = ids.find(s);
+    if (it != ids.end()) return it->second;
+    int id = static_cast<int>(subsets.size());
+    ids[s] = id;
+    subsets.push_back(s);
+    result.next.emplace_back();
+    result.next.back().fill(dfa::dead);
+    result.accept.push_back(subset_accept(s, priority, types));
+    return id;
+  };
+
+  get_id({});
+  std::set<uint32_t> initial;
+  add_state(arena, start, initial);
+  result.start = get_id(initial);
+
+  for (size_t i = 1; i < subsets.size(); ++i) {
+    std::array<std::set<uint32_t>, 256> moves;
+    for (auto s : subsets[i]) {
+      for (auto &tr : arena[s].out) {
+        if (tr.type == transition_type::CHAR) {
+          add_state(arena, tr.next, moves[static_cast<unsigned char>(tr.c)]);
+        } else if (tr.type == transition_type::ANY) {
+          for (auto &move : moves) add_state(arena, tr.next, move);
+        }
+      }
+    }
+    for (int c = 0; c < 256; ++c) {
+      if (!moves[c].empty()) result.next[i][c] = get_id(moves[c]);
+    }
+  }
+
+  return result;
+}
+
+// ======================== Minimizacion de Hopcroft
+// ======================================
+
+// Refina la particion inicial (estados agrupados por token aceptado) hasta
+// que no quede ningun bloque distinguible. El estado muerto sigue siendo el 0
+// y el inicial el 1.
+dfa minimize(const dfa &d) {
+  const int n = d.size();
+
+  // transiciones inversas: inverse[c][t] = estados q con next[q][c] == t
+  std::vector<std::vector<std::vector<int>>> inverse(
+      256, std::vector<std::vector<int>>(n));
+  for (int q = 0; q < n; ++q)
+    for (int c = 0; c < 256; ++c) inverse[c][d.next[q][c]].push_back(q);
+
+  std::vector<std::vector<int>> blocks;
+  std::vector<int> block_of(n);
+  std::map<token_type, int> initial;
+  for (int q = 0; q < n; ++q) {
+    auto it = initial.find(d.accept[q]);
+    if (it == initial.end()) {
+      it = initial.emplace(d.accept[q], static_cast<int>(blocks.size())).first;
+      blocks.emplace_back();
+    }
+    block_of[q] = it->second;
+    blocks[it->second].push_back(q);
+  }
+
+  std::vector<int> worklist;
+  std::vector<bool> in_worklist(blocks.size(), true);
+  for (int b = 0; b < static_cast<int>(blocks.size()); ++b) worklist.push_back(b);
+
+  std::vector<std::vector<int>> touched(n);
+  std::vector<int> touched_blocks;
+  std::vector<bool> marked(n, false);
+
+  while (!worklist.empty()) {
+    int splitter = worklist.back();
+    worklist.pop_back();
+    in_worklist[splitter] = false;
+    const std::vector<int> members = blocks[splitter];
+
+    for (int c = 0; c < 256; ++c) {
+      touched_blocks.clear();
+      for (int t : members) {
+        for (int q : inverse[c][t]) {
+          if (marked[q]) continue;
+          marked[q] = true;
+          int b = block_of[q];
+          if (touched[b].empty()) touched_blocks.push_back(b);
+          touched[b].push_back(q);
+        }
+      }
+
+      for (int b : touched_blocks) {
+        if (touched[b].size() < blocks[b].size()) {
+          int nb = static_cast<int>(blocks.size());
+          std::vector<int> rest;
+          for (int q : blocks[b])
+            if (!marked[q]) rest.push_back(q);
+          blocks[b] = std::move(rest);
+          blocks.push_back(touched[b]);
+          for (int q : blocks[nb]) block_of[q] = nb;
+
+          if (in_worklist[b]) {
+            worklist.push_back(nb);
+            in_worklist.push_back(true);
+          } else {
+            int smaller = blocks[nb].size() < blocks[b].size() ? nb : b;
+            in_worklist.push_back(false);
+            worklist.push_back(smaller);
+            in_worklist[smaller] = true;
+          }
+        }
+        for (int q : touched[b]) marked[q] = false;
+        touched[b].clear();
+      }
+    }
+  }
+
+  // Renumerar: muerto -> 0, inicial -> 1, el resto en orden de aparicion
+  std::vector<int> new_id(blocks.size(), -1);
+  int count = 0;
+  new_id[block_of[0]] = count++;
+  if (new_id[block_of[d.start]] < 0) new_id[block_of[d.start]] = count++;
+  for (int q = 0; q < n; ++q)
+    if (new_id[block_of[q]] < 0) new_id[block_of[q]] = count++;
+
+  dfa result;
+  result.next.resize(count);
+  result.accept.resize(count);
+  result.start = new_id[block_of[d.start]];
+  for (int q = 0; q < n; ++q) {
+    int id = new_id[block_of[q]];
+    result.accept[id] = d.accept[q];
+    for (int c = 0; c < 256; ++c) result.next[id][c] = new_id[block_of[d.next[q][c]]];
+  }
+  return result;
+}
+
+// ======================== Compresion en clases de bytes
+// ======================================
+
+// Dos bytes son de la misma clase si todos los estados transitan igual con
+// ambos (es decir, ninguna clase de caracteres de las regex los distingue)
+dfa_table compress(const dfa &d) {
+  dfa_table result;
+  std::map<std::vector<int>, uint8_t> columns;
+
+  for (int c = 0; c < 256; ++c) {
+    std::vector<int> column(d.size());
+    for (int q = 0; q < d.size(); ++q) column[q] = d.next[q][c];
+    auto it = columns.find(column);
+    if (it == columns.end())
+      it = columns.emplace(column, static_cast<uint8_t>(columns.size())).first;
+    result.byte_class[c] = it->second;
+  }
+
+  result.classes = static_cast<uint16_t>(columns.size());
+  result.start = static_cast<uint16_t>(d.start);
+  result.accept = d.accept;
+  result.next.resize(static_cast<size_t>(d.size()) * result.classes);
+  for (int q = 0; q < d.size(); ++q)
+    for (int c = 0; c < 256; ++c)
+      result.next[q * result.classes + result.byte_class[c]] =
+          static_cast<uint16_t>(d.next[q][c]);
+  return result;
+}
+
+dfa_table build_dfa(
+    const std::vector<std::pair<std::string, token_type>> &table) {
+  return compress(minimize(subset_construction(table)));
+}
+
+}  // namespace lexer
+
+}  // namespace hulk
+
+#endif  // HULK_DFA_HPP
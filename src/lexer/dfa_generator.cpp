@@ -0,0 +1,77 @@
+// Genera dfa_tables.hpp con el DFA minimizado de regexs_tokens, para que el
+// lexer no tenga que construir ningun automata al arrancar.
+// Uso: dfa_generator <salida>   (lo llama el Makefile cuando cambia el lexer)
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "dfa.hpp"
+#include "tokens.hpp"
+
+using namespace hulk::lexer;
+
+template <class T>
+void write_array(std::ostream &out, const T *data, size_t size,
+                 size_t per_line) {
+  for (size_t i = 0; i < size; ++i) {
+    if (i % per_line == 0) out << "\n    ";
+    out << +data[i] << ",";
+  }
+  out << "\n";
+}
+
+void write_tables(std::ostream &out, const dfa_table &d) {
+  const size_t states = d.accept.size();
+
+  out << "// Generado por dfa_generator.cpp a partir de regexs_tokens, no editar.\n"
+      << "#ifndef HULK_DFA_TABLES_HPP\n"
+      << "#define HULK_DFA_TABLES_HPP 1\n\n"
+      << "#include <cstdint>\n\n"
+      << "#include \"dfa.hpp\"\n"
+      << "#include \"tokens.hpp\"\n\n"
+      << "namespace hulk {\n\n"
+      << "namespace lexer {\n\n"
+      << "namespace tables {\n\n"
+      << "// " << states << " estados, " << d.classes << " clases de bytes\n"
+      << "constexpr uint16_t classes = " << d.classes << ";\n"
+      << "constexpr uint16_t start = " << d.start << ";\n\n";
+
+  out << "constexpr uint8_t byte_class[256] = {";
+  write_array(out, d.byte_class.data(), d.byte_class.size(), 16);
+  out << "};\n\n";
+
+  out << "constexpr uint16_t next[" << states << " * " << d.classes << "] = {";
+  write_array(out, d.next.data(), d.next.size(), d.classes);
+  out << "};\n\n";
+
+  out << "constexpr token_type accept[" << states << "] = {\n";
+  for (auto type : d.accept)
+    out << "    token_type::" << token_type_to_string(type) << ",\n";
+  out << "};\n\n"
+      << "}  // namespace tables\n\n"
+      << "// DFA de los tokens de Hulk\n"
+      << "constexpr dfa_view tokens_dfa() {\n"
+      << "  return {tables::byte_class, tables::classes, tables::start,\n"
+      << "          tables::next, tables::accept};\n"
+      << "}\n\n"
+      << "}  // namespace lexer\n\n"
+      << "}  // namespace hulk\n\n"
+      << "#endif  // HULK_DFA_TABLES_HPP\n";
+}
+
+int main(const int argc, char **argv) {
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0] << " <output>" << std::endl;
+    return 1;
+  }
+
+  std::ofstream out(argv[1]);
+  if (out.fail()) {
+    std::cerr << "Failed to open " << argv[1] << std::endl;
+    return 1;
+  }
+
+  write_tables(out, build_dfa(regexs_tokens));
+  return 0;
+}
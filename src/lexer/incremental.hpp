@@ -0,0 +1,169 @@
+#ifndef HULK_INCREMENTAL_HPP
+#define HULK_INCREMENTAL_HPP 1
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../internal/internal_uncopyable.hpp"
+#include "lexer.hpp"
+#include "tokens.hpp"
+
+namespace hulk {
+
+namespace lexer {
+
+/*  Lexer incremental (para el editor o el modo watch)
+    Guarda el texto, sus tokens y para cada token donde empieza, donde
+    termina y hasta que byte tuvo que mirar el lexer para decidirlo. Entre
+    token y token el lexer no tiene estado (el DFA empieza de cero), asi que
+    el final de cada token es un punto de control desde donde se puede
+    volver a lexear.
+    Al editar [offset, offset + length):
+        1. los tokens que no miraron ningun byte desde offset quedan igual,
+        2. se lexea desde el final del ultimo de ellos,
+        3. en cuanto un token nuevo termina (despues de la edicion) donde
+           terminaba uno viejo, el resto de los tokens viejos se reusa
+           corrido en posicion, linea y columna.
+    edit devuelve que rango de tokens cambio para que las fases siguientes
+    hagan lo minimo.
+    Un caracter inesperado queda como un token UNKNOWN, igual que en lex,
+    pero aca no se reporta (el editor lo marca).
+*/
+
+// Los tokens [first, first + removed) de antes de la edicion se
+// reemplazaron por [first, first + inserted). Los de despues del rango son
+// los mismos pero pueden haber cambiado de linea o columna.
+struct token_change {
+  size_t first = 0;
+  size_t removed = 0;
+  size_t inserted = 0;
+};
+
+struct incremental_lexer : private internal::uncopyable {
+  explicit incremental_lexer(std::string_view _text) {
+    tokens.push_back(token(token_type::END_OF_FILE, "", nullptr, 1, 1));
+    spans.push_back({0, 0, 0});
+    edit(0, 0, _text);
+  }
+
+  // Reemplaza text[offset, offset + length) por replacement
+  token_change edit(size_t offset, size_t length, std::string_view replacement) {
+    if (offset > text.size() || length > text.size() - offset)
+      throw std::out_of_range("Edit out of range");
+
+    const size_t old_count = tokens.size() - 1;  // sin END_OF_FILE
+    const ptrdiff_t delta = static_cast<ptrdiff_t>(replacement.size()) -
+                            static_cast<ptrdiff_t>(length);
+
+    // primer token que miro algun byte desde offset (reach es creciente)
+    const size_t first =
+        std::lower_bound(spans.begin(), spans.begin() + old_count, offset,
+                         [](const token_span &s, size_t value) {
+                           return s.reach < value;
+                         }) -
+        spans.begin();
+
+    lex_position at;
+    if (first > 0)
+      at = {spans[first - 1].end, static_cast<int>(tokens[first - 1].line),
+            static_cast<int>(tokens[first - 1].column), spans[first - 1].reach};
+
+    const char *old_data = text.data();
+    text.replace(offset, length, replacement);
+    const size_t edit_end = offset + replacement.size();
+
+    // volver a lexear hasta resincronizar con los tokens viejos
+    std::vector<token> fresh;
+    std::vector<token_span> fresh_spans;
+    size_t resume = old_count;  // primer token viejo que se reusa
+    bool resynced = false;
+    token next;
+    for (;;) {
+      lex_status status = lex_token(text, text.size(), at, true, next);
+      if (status == lex_status::END) break;
+      size_t start = next.lexeme.data() - text.data();
+      fresh_spans.push_back({start, at.pos, at.scanned});
+      fresh.push_back(std::move(next));
+
+      if (at.pos >= edit_end) {
+        const size_t old_end = static_cast<size_t>(static_cast<ptrdiff_t>(at.pos) - delta);
+        auto it = std::lower_bound(spans.begin() + first,
+                                   spans.begin() + old_count, old_end,
+                                   [](const token_span &s, size_t value) {
+                                     return s.end < value;
+                                   });
+        if (it != spans.begin() + old_count && it->end == old_end) {
+          resume = it - spans.begin() + 1;
+          resynced = true;
+          break;
+        }
+      }
+    }
+
+    // correr los tokens que se reusan (y END_OF_FILE)
+    if (resynced) {
+      const token &sync = tokens[resume - 1];
+      const int line_shift = at.line - static_cast<int>(sync.line);
+      const int column_shift = at.column - static_cast<int>(sync.column);
+      const unsigned int sync_line = sync.line;
+      for (size_t i = resume; i < tokens.size(); ++i) {
+        if (tokens[i].line == sync_line) tokens[i].column += column_shift;
+        tokens[i].line += line_shift;
+      }
+    }
+    size_t reach = at.scanned;
+    for (size_t i = resume; i < old_count; ++i) {
+      spans[i].begin += delta;
+      spans[i].end += delta;
+      reach = std::max(reach, static_cast<size_t>(spans[i].reach + delta));
+      spans[i].reach = reach;
+      tokens[i].lexeme = std::string_view(text).substr(spans[i].begin, tokens[i].lexeme.size());
+    }
+    if (text.data() != old_data)
+      for (size_t i = 0; i < first; ++i)
+        tokens[i].lexeme = std::string_view(text).substr(spans[i].begin, tokens[i].lexeme.size());
+
+    token_change change{first, resume - first, fresh.size()};
+    if (change.removed == change.inserted) {  // lo normal al editar una linea
+      std::move(fresh.begin(), fresh.end(), tokens.begin() + first);
+      std::copy(fresh_spans.begin(), fresh_spans.end(), spans.begin() + first);
+    } else {
+      tokens.erase(tokens.begin() + first, tokens.begin() + resume);
+      tokens.insert(tokens.begin() + first, std::make_move_iterator(fresh.begin()),
+                    std::make_move_iterator(fresh.end()));
+      spans.erase(spans.begin() + first, spans.begin() + resume);
+      spans.insert(spans.begin() + first, fresh_spans.begin(), fresh_spans.end());
+    }
+
+    if (!resynced)  // se lexeo hasta el final
+      tokens.back() = token(token_type::END_OF_FILE, "", nullptr, at.line, at.column);
+    spans.back() = {text.size(), text.size(), text.size()};
+    return change;
+  }
+
+  std::string_view source() const { return text; }
+
+  // Incluye el END_OF_FILE final, igual que lex
+  const std::vector<token> &get_tokens() const { return tokens; }
+
+ private:
+  struct token_span {
+    size_t begin, end;  // [begin, end) en text
+    size_t reach;       // byte mas lejano mirado hasta este token (inclusive)
+  };
+
+  std::string text;
+  std::vector<token> tokens;
+  std::vector<token_span> spans;  // uno por token
+};
+
+}  // namespace lexer
+
+}  // namespace hulk
+
+#endif  // HULK_INCREMENTAL_HPP
@@ -0,0 +1,105 @@
+#ifndef HULK_KEYWORDS_HPP
+#define HULK_KEYWORDS_HPP 1
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "tokens.hpp"
+
+namespace hulk {
+
+namespace lexer {
+
+/*  Palabras reservadas
+    El DFA reconoce cada palabra como IDENTIFIER y despues se busca en esta
+    tabla con un hash perfecto (sin colisiones, comprobado en tiempo de
+    compilacion), asi las palabras clave no agregan estados al DFA y agregar
+    una nueva es solo agregarla aqui.
+    Si se agrega una que colisiona el static_assert de abajo falla y hay que
+    cambiar keyword_hash o keyword_slots.
+*/
+
+struct keyword {
+  std::string_view text;
+  token_type type;
+};
+
+constexpr std::array<keyword, 18> keywords = {{
+    {"Null", token_type::T_NULL},
+    {"if", token_type::KW_IF},
+    {"elif", token_type::KW_ELIF},
+    {"else", token_type::KW_ELSE},
+    {"while", token_type::KW_WHILE},
+    {"for", token_type::KW_FOR},
+    {"function", token_type::KW_FUNCTION},
+    {"let", token_type::KW_LET},
+    {"in", token_type::KW_IN},
+    {"type", token_type::KW_TYPE},
+    {"new", token_type::KW_NEW},
+    {"inherits", token_type::KW_INHERITS},
+    // {"base", token_type::KW_BASE},
+    {"protocol", token_type::KW_PROTOCOL},
+    {"extends", token_type::KW_EXTENDS},
+    {"true", token_type::TRUE},
+    {"false", token_type::FALSE},
+    // {"Object", token_type::T_OBJECT},
+    // {"Number", token_type::T_NUMBER},
+    // {"Boolean", token_type::T_BOOLEAN},
+    // {"String", token_type::T_STRING},
+    // {"Char", token_type::T_CHAR},
+    {"is", token_type::OP_IS},
+    {"as", token_type::OP_AS},
+}};
+
+constexpr size_t keyword_min_length = 2;
+constexpr size_t keyword_max_length = 8;
+constexpr size_t keyword_slots = 32;
+
+// Solo se llama con palabras de al menos keyword_min_length caracteres
+constexpr size_t keyword_hash(std::string_view word) {
+  return (4 * word.size() + static_cast<unsigned char>(word[0]) +
+          static_cast<unsigned char>(word[1]) +
+          static_cast<unsigned char>(word[word.size() - 1])) %
+         keyword_slots;
+}
+
+// slot -> indice en keywords (-1 si esta vacio)
+constexpr std::array<int8_t, keyword_slots> make_keyword_table() {
+  std::array<int8_t, keyword_slots> table{};
+  for (auto &slot : table) slot = -1;
+  for (size_t i = 0; i < keywords.size(); ++i)
+    table[keyword_hash(keywords[i].text)] = static_cast<int8_t>(i);
+  return table;
+}
+
+constexpr std::array<int8_t, keyword_slots> keyword_table = make_keyword_table();
+
+constexpr bool keyword_hash_is_perfect() {
+  for (size_t i = 0; i < keywords.size(); ++i) {
+    if (keywords[i].text.size() < keyword_min_length ||
+        keywords[i].text.size() > keyword_max_length)
+      return false;
+    if (keyword_table[keyword_hash(keywords[i].text)] != static_cast<int8_t>(i))
+      return false;
+  }
+  return true;
+}
+
+static_assert(keyword_hash_is_perfect(),
+              "keyword_hash tiene colisiones entre las palabras clave");
+
+// Devuelve el token_type de la palabra clave o IDENTIFIER si no lo es
+constexpr token_type classify_word(std::string_view word) {
+  if (word.size() < keyword_min_length || word.size() > keyword_max_length)
+    return token_type::IDENTIFIER;
+  int8_t slot = keyword_table[keyword_hash(word)];
+  if (slot >= 0 && keywords[slot].text == word) return keywords[slot].type;
+  return token_type::IDENTIFIER;
+}
+
+}  // namespace lexer
+
+}  // namespace hulk
+
+#endif  // HULK_KEYWORDS_HPP
@@ -1,15 +1,24 @@
 #ifndef HULK_LEXER_HPP
 #define HULK_LEXER_HPP 1
 
+#include <algorithm>
+#include <charconv>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 #include <regex>
 #include <unordered_map>
 
 #include "../lexer/tokens.hpp"
+#include "dfa.hpp"
+#include "dfa_tables.hpp"
+#include "keywords.hpp"
 #include "regex_engine.hpp"
+#include "scan.hpp"
 
 namespace hulk {
 
@@ -28,72 +37,301 @@ std::unordered_map<std::string, std::string> escape_mapping = {
     {"\\\\", "\\"}  // Backslash
 };
 
-std::vector<token> lex(const std::string &input) {
-  std::vector<std::pair<nfa, token_type>> nfas;
-  std::vector<token> tokens;
-  size_t pos = 0, n = input.size();
+// Valor de un NUMBER ([0-9]*([.][0-9]+)?, el DFA nunca acepta el lexema
+// vacio) leido directo del buffer: from_chars no copia, no depende del
+// locale, no lanza excepciones y redondea correctamente
+double number_value(std::string_view lexeme) {
+  double value = 0;
+  auto result = std::from_chars(lexeme.data(), lexeme.data() + lexeme.size(), value);
+  if (result.ec == std::errc::result_out_of_range) {
+    // cientos de digitos: si la parte entera no es 0 se paso por arriba,
+    // si no es un decimal demasiado chico
+    size_t integer = lexeme.find_first_not_of('0');
+    bool huge = integer != std::string_view::npos && lexeme[integer] != '.';
+    value = huge ? std::numeric_limits<double>::infinity() : 0.0;
+  }
+  return value;
+}
+
+// Donde va el lexer dentro de la entrada
+struct lex_position {
+  size_t pos = 0;
   int line = 1, column = 1;
+  size_t scanned = 0;  // byte mas lejano que se miro (lo usa incremental.hpp)
+};
 
-  // Crear los NFA para cada regex
-  for (auto &rt : regexs_tokens) {  // rt: <regex, type>
-    parser p(rt.first);
-    nfas.push_back({p.parse(), rt.second});
-  }
+enum class lex_status {
+  TOKEN,  // se escribio un token en out
+  END,    // se llego a stop sin encontrar mas tokens
+  ERROR   // caracter inesperado: out es un token UNKNOWN con el
+};
+
+// Lexea el siguiente token desde at saltando espacios y comentarios, y deja
+// at al final del token. Un token que empieza antes de stop puede terminar
+// despues. Si intern_ids es falso los identificadores quedan con
+// empty_symbol (la tabla de symbols no se puede usar desde varios hilos).
+// Un caracter que no empieza ningun token no corta nada: sale como un token
+// UNKNOWN (con sus bytes de continuacion UTF-8) y el lexer sigue despues.
+lex_status lex_token(std::string_view input, size_t stop, lex_position &at,
+                     bool intern_ids, token &out) {
+  static constexpr dfa_view automaton = tokens_dfa();
+  const scan_kernels &scan = scanner();
+  const char *const begin = input.data(), *const end = begin + input.size();
+  size_t &pos = at.pos;
+  const size_t n = input.size();
+
+  // un token depende de todos los bytes que se miraron para decidirlo
+  auto saw = [&](size_t last) {
+    if (last > at.scanned) at.scanned = last;
+  };
+
+  // actualizar línea/columna al pasar por [from, to)
+  auto advance = [&](size_t from, size_t to) {
+    line_count newlines = scan.count_lines(begin + from, begin + to);
+    if (newlines.lines) {
+      at.line += newlines.lines;
+      at.column = static_cast<int>(begin + to - newlines.last_newline);
+    } else
+      at.column += static_cast<int>(to - from);
+  };
+
+  while (pos < stop) {
+    const unsigned char c = input[pos];
+
+    // caminos rapidos (scan.hpp): espacios, saltos de linea y comentarios //
+    // se saltan sin pasar por el DFA
+    if (is_blank(c)) {
+      size_t next = scan.skip_blanks(begin + pos, end) - begin;
+      saw(next);
+      advance(pos, next);
+      pos = next;
+      continue;
+    }
+    if (c == '/' && pos + 1 < n && input[pos + 1] == '/') {
+      size_t next = scan.comment_end(begin + pos + 2, end) - begin;
+      saw(next);
+      at.column += static_cast<int>(next - pos);
+      pos = next;
+      continue;
+    }
 
-  while (pos < n) {
     size_t max_len = 0;
     token_type best_type = token_type::UNKNOWN;
 
-    for (size_t len = 1; pos + len <= n; ++len) {
-      for (auto &nfa : nfas) {
-        std::string sub = input.substr(pos, len);
-        if (match(nfa.first, sub) && len > max_len) {
-          max_len = len;
-          best_type = nfa.second;
+    // el cuerpo de un string llega hasta el primer byte que no puede estar
+    // dentro; si no es la comilla que lo cierra decide el DFA
+    if (c == '"') {
+      const char *close = scan.string_end(begin + pos + 1, end);
+      saw(close - begin);
+      if (close < end && *close == '"') {
+        max_len = close + 1 - (begin + pos);
+        best_type = token_type::STRING;
+      }
+    }
+
+    // maximal munch: avanzar por el DFA hasta caer en el estado muerto,
+    // recordando el ultimo estado de aceptacion visto
+    if (max_len == 0) {
+      uint16_t s = automaton.start;
+      size_t i = pos;
+      for (; i < n; ++i) {
+        s = automaton.step(s, static_cast<unsigned char>(input[i]));
+        if (s == dfa_view::dead) break;
+        if (automaton.accept[s] != token_type::UNKNOWN) {
+          max_len = i - pos + 1;
+          best_type = automaton.accept[s];
         }
       }
+      saw(i);
     }
 
-    if (max_len == 0) {  
-      internal::lexical_error(line, column, "Unexpected caracter.");
-      exit(0);
+    if (max_len == 0) {
+      size_t length = 1;
+      while (pos + length < n &&
+             (static_cast<unsigned char>(input[pos + length]) & 0xC0) == 0x80)
+        ++length;
+      saw(pos + length);
+      std::string_view lexeme = input.substr(pos, length);
+      advance(pos, pos + length);
+      pos += length;
+      out = token(token_type::UNKNOWN, lexeme, nullptr, at.line, at.column);
+      return lex_status::ERROR;
     }
 
-    std::string lexeme = input.substr(pos, max_len);
+    std::string_view lexeme = input.substr(pos, max_len);
+    if (best_type == IDENTIFIER) best_type = classify_word(lexeme);
+    advance(pos, pos + max_len);
+    pos += max_len;
+
+    // saltar WHITESPACE, COMMENT y NEWLINE
+    if (best_type == token_type::WHITESPACE ||
+        best_type == token_type::COMMENT || best_type == token_type::NEWLINE)
+      continue;
+
     literal value;
 
+    // solo los strings necesitan una copia propia (sin las comillas)
     if (best_type == NUMBER) {  // number
-      value = stod(lexeme);
+      value = number_value(lexeme);
     } else if (best_type == TRUE || best_type == FALSE) {  // boolean
       value = (best_type == TRUE ? true : false);
-    } else {
-      value = lexeme.substr(1, lexeme.size() - 2);
+    } else if (best_type == STRING) {
+      value = std::string(lexeme.substr(1, lexeme.size() - 2));
     }
 
-    // actualizar línea/columna
-    for (char c : lexeme) {
-      if (c == '\n') {
-        line++;
-        column = 1;
-      } else
-        column++;
-    }
+    symbol id = best_type == IDENTIFIER && intern_ids ? intern(lexeme)
+                                                      : empty_symbol;
+    out = token(best_type, lexeme, std::move(value), at.line, at.column, id);
+    return lex_status::TOKEN;
+  }
+
+  return lex_status::END;
+}
 
-    token tok(best_type, lexeme, value, line, column);
+// Reporta el caracter de un token UNKNOWN, en la posicion donde empieza
+void unexpected_character(const token &t) {
+  internal::lexical_error(t.line, t.column - static_cast<unsigned>(t.lexeme.size()),
+                          "Unexpected caracter.");
+}
 
-    // agregar si no es WHITESPACE ni COMMENT ni NEWLINE
-    if (best_type != token_type::WHITESPACE &&
-        best_type != token_type::COMMENT && best_type != token_type::NEWLINE) {
-      tokens.push_back(tok);
+// Resultado de lexear un tramo de la entrada
+struct lex_chunk {
+  std::vector<token> tokens;
+  size_t end = 0;            // donde termino el ultimo token
+  int line = 1, column = 1;  // posicion en end
+};
+
+// Lexea input desde from hasta pasar stop. line/column son los de from.
+void lex_range(std::string_view input, size_t from, size_t stop, int line,
+               int column, bool intern_ids, lex_chunk &out) {
+  lex_position at{from, line, column};
+  lex_status status;
+  do {
+    out.tokens.emplace_back();  // lex_token escribe directo en el vector
+    status = lex_token(input, stop, at, intern_ids, out.tokens.back());
+  } while (status != lex_status::END);
+  out.tokens.pop_back();
+
+  out.end = at.pos;
+  out.line = at.line;
+  out.column = at.column;
+}
+
+// ======================== Lexer en paralelo
+// ======================================
+
+/*  Para entradas grandes la entrada se parte en tramos que se lexean en
+    hilos distintos:
+        1. pre-scan: cada tramo empieza en el primer caracter que no es
+           espacio despues de un '\n' (ahi empieza un token, salvo que el
+           '\n' este dentro de un string o de un comentario de bloque),
+        2. cada hilo lexea su tramo con lineas relativas al inicio,
+        3. se concatenan los tokens en orden corrigiendo las lineas e
+           internando los identificadores.
+    Un tramo solo se usa si el anterior termino exactamente donde el empieza.
+    Si no (el corte cayo dentro de un string o comentario) ese pedazo se
+    vuelve a lexear en secuencia desde donde termino el anterior, asi el
+    resultado siempre es igual al del lexer secuencial.
+*/
+
+constexpr size_t parallel_lex_min_size = 1 << 20;    // 1 MB
+constexpr size_t parallel_lex_min_chunk = 256 << 10;  // 256 KB por hilo
+
+// Cantidad de hilos que usa lex(input) para una entrada de ese tamaño
+unsigned lex_threads(size_t size) {
+  if (size < parallel_lex_min_size) return 1;
+  size_t by_size = size / parallel_lex_min_chunk;
+  size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+  return static_cast<unsigned>(std::min(by_size, hardware));
+}
+
+// Inicios de los tramos (el primero es 0)
+std::vector<size_t> lex_boundaries(std::string_view input, unsigned chunks) {
+  const scan_kernels &scan = scanner();
+  const char *const begin = input.data(), *const end = begin + input.size();
+  std::vector<size_t> starts = {0};
+
+  for (unsigned i = 1; i < chunks; ++i) {
+    size_t target = std::max(input.size() * i / chunks, starts.back() + 1);
+    if (target >= input.size()) break;
+    size_t newline = input.find('\n', target);
+    if (newline == std::string_view::npos) break;
+    size_t start = scan.skip_blanks(begin + newline, end) - begin;
+    if (start >= input.size()) break;
+    starts.push_back(start);
+  }
+  return starts;
+}
+
+std::vector<token> lex(std::string_view input, unsigned threads) {
+  std::vector<size_t> starts = lex_boundaries(input, std::max(threads, 1u));
+  const size_t chunks = starts.size();
+  starts.push_back(input.size());
+  std::vector<lex_chunk> results(chunks);
+
+  if (chunks == 1) {
+    lex_chunk &all = results[0];
+    lex_range(input, 0, input.size(), 1, 1, true, all);
+    for (const auto &t : all.tokens)
+      if (t.type == UNKNOWN) unexpected_character(t);
+    all.tokens.push_back(
+        token(token_type::END_OF_FILE, "", nullptr, all.line, all.column));
+    return std::move(all.tokens);
+  }
+
+  scanner();  // elegir los kernels antes de arrancar los hilos
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < chunks; ++i) {
+    workers.emplace_back([&, i] {
+      // columna del inicio del tramo: distancia al ultimo '\n'
+      size_t newline = i ? input.rfind('\n', starts[i] - 1) : 0;
+      int column = i ? static_cast<int>(starts[i] - newline) : 1;
+      lex_range(input, starts[i], starts[i + 1], 1, column, false, results[i]);
+    });
+  }
+  for (auto &worker : workers) worker.join();
+
+  std::vector<token> tokens;
+  size_t total = 0;
+  for (auto &chunk : results) total += chunk.tokens.size();
+  tokens.reserve(total + 1);
+
+  size_t pos = 0;
+  int line = 1, column = 1;
+  for (size_t i = 0; i < chunks; ++i) {
+    if (pos >= starts[i + 1]) continue;  // el anterior ya cubrio el tramo
+
+    lex_chunk relexed;
+    lex_chunk *chunk = &results[i];
+    int offset = line - 1;
+    if (pos != starts[i]) {
+      // el corte no era el inicio de un token: lexear desde pos
+      lex_range(input, pos, starts[i + 1], line, column, true, relexed);
+      chunk = &relexed;
+      offset = 0;
     }
 
-    pos += max_len;
+    for (auto &t : chunk->tokens) {
+      t.line += offset;
+      if (t.type == IDENTIFIER && t.id == empty_symbol) t.id = intern(t.lexeme);
+      if (t.type == UNKNOWN) unexpected_character(t);
+      tokens.push_back(std::move(t));
+    }
+    pos = chunk->end;
+    line = chunk->line + offset;
+    column = chunk->column;
   }
 
   tokens.push_back(token(token_type::END_OF_FILE, "", nullptr, line, column));
   return tokens;
 }
 
+// Los tokens guardan vistas sobre input, que tiene que seguir vivo mientras
+// se usen
+std::vector<token> lex(std::string_view input) {
+  return lex(input, lex_threads(input.size()));
+}
+
 }  // namespace lexer
 
 }  // namespace hulk
@@ -1,10 +1,12 @@
 #ifndef HULK_REGEX_ENGINE_HPP
 #define HULK_REGEX_ENGINE_HPP 1
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
-#include <memory>
 #include <set>
 #include <stack>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -27,9 +29,6 @@ namespace lexer {
 // ======================== Estructuras de datos para el NFA
 // ======================================
 
-struct state;
-using state_ptr = std::shared_ptr<state>;
-
 // Su nombre esta claro XD
 enum class transition_type {
   CHAR,    // consume el caracter especifico
@@ -40,8 +39,8 @@ enum class transition_type {
 // Representa una transicion: <tipo, caracter, destino>
 struct transition {
   transition_type type;
-  char c;          // solo cuando type == CHAR
-  state_ptr next;  // destimo
+  char c;         // solo cuando type == CHAR
+  uint32_t next;  // destino: indice del estado en el nfa_arena
 };
 
 // Estado de un NFA que tiene las transiciones posibles y si es un estado final
@@ -50,12 +49,30 @@ struct state {
   bool is_accept = false;
 };
 
+// Dueño de todos los estados: se guardan contiguos y se refieren por indice,
+// asi los ciclos epsilon (star_nfa) no son ciclos de punteros y todo se libera
+// junto con el arena
+struct nfa_arena {
+  std::vector<state> states;
+
+  uint32_t new_state() {
+    states.emplace_back();
+    return static_cast<uint32_t>(states.size() - 1);
+  }
+
+  // ojo: la referencia deja de ser valida al crear un nuevo estado
+  state &operator[](uint32_t s) { return states[s]; }
+  const state &operator[](uint32_t s) const { return states[s]; }
+
+  size_t size() const { return states.size(); }
+};
+
 //  Un NFA se define como un estado de inicio y uno de final,
 // para poder usarlo en la construccion de Thompson
 struct nfa {
-  state_ptr start;
-  state_ptr accept;  // no tiene xq ser un estado aceptado necesariamete ya q
-                     // cambia con la construccion
+  uint32_t start;
+  uint32_t accept;  // no tiene xq ser un estado aceptado necesariamete ya q
+                    // cambia con la construccion
 };
 
 // =============================== Construcción de Thompson
@@ -65,11 +82,11 @@ struct nfa {
 s → t
 con transicion de tipo CHAR
 */
-nfa char_nfa(char c) {
-  auto s = std::make_shared<state>();
-  auto t = std::make_shared<state>();
-  s->out.push_back({transition_type::CHAR, c, t});
-  t->is_accept = true;
+nfa char_nfa(nfa_arena &arena, char c) {
+  uint32_t s = arena.new_state();
+  uint32_t t = arena.new_state();
+  arena[s].out.push_back({transition_type::CHAR, c, t});
+  arena[t].is_accept = true;
   return {s, t};
 }
 
@@ -77,11 +94,11 @@ nfa char_nfa(char c) {
 s → t
 con transicion de tipo ANY
 */
-nfa any_nfa() {
-  auto s = std::make_shared<state>();
-  auto t = std::make_shared<state>();
-  s->out.push_back({transition_type::ANY, 0, t});
-  t->is_accept = true;
+nfa any_nfa(nfa_arena &arena) {
+  uint32_t s = arena.new_state();
+  uint32_t t = arena.new_state();
+  arena[s].out.push_back({transition_type::ANY, 0, t});
+  arena[t].is_accept = true;
   return {s, t};
 }
 
@@ -89,9 +106,9 @@ nfa any_nfa() {
 a → b
 con transicion EPSILON
 */
-nfa concat_nfa(nfa a, nfa b) {
-  a.accept->is_accept = false;
-  a.accept->out.push_back({transition_type::EPSILON, 0, b.start});
+nfa concat_nfa(nfa_arena &arena, nfa a, nfa b) {
+  arena[a.accept].is_accept = false;
+  arena[a.accept].out.push_back({transition_type::EPSILON, 0, b.start});
   return {a.start, b.accept};
 }
 
@@ -101,16 +118,16 @@ s . . . t
  ↘ b ↗
 con transiciones EPSILON
 */
-nfa alt_nfa(nfa a, nfa b) {
-  auto s = std::make_shared<state>();
-  auto t = std::make_shared<state>();
-  s->out.push_back({transition_type::EPSILON, 0, a.start});
-  s->out.push_back({transition_type::EPSILON, 0, b.start});
-  a.accept->is_accept = false;
-  b.accept->is_accept = false;
-  a.accept->out.push_back({transition_type::EPSILON, 0, t});
-  b.accept->out.push_back({transition_type::EPSILON, 0, t});
-  t->is_accept = true;
+nfa alt_nfa(nfa_arena &arena, nfa a, nfa b) {
+  uint32_t s = arena.new_state();
+  uint32_t t = arena.new_state();
+  arena[s].out.push_back({transition_type::EPSILON, 0, a.start});
+  arena[s].out.push_back({transition_type::EPSILON, 0, b.start});
+  arena[a.accept].is_accept = false;
+  arena[b.accept].is_accept = false;
+  arena[a.accept].out.push_back({transition_type::EPSILON, 0, t});
+  arena[b.accept].out.push_back({transition_type::EPSILON, 0, t});
+  arena[t].is_accept = true;
   return {s, t};
 }
 
@@ -120,17 +137,17 @@ s → a → t
 . . . ↻
 con transiciones EPSILON
 */
-nfa star_nfa(nfa a) {
-  auto s = std::make_shared<state>();
-  auto t = std::make_shared<state>();
+nfa star_nfa(nfa_arena &arena, nfa a) {
+  uint32_t s = arena.new_state();
+  uint32_t t = arena.new_state();
   // desde nuevo inicio a A y a nuevo fin
-  s->out.push_back({transition_type::EPSILON, 0, a.start});
-  s->out.push_back({transition_type::EPSILON, 0, t});
+  arena[s].out.push_back({transition_type::EPSILON, 0, a.start});
+  arena[s].out.push_back({transition_type::EPSILON, 0, t});
   // desde fin de A a inicio de A y a nuevo fin
-  a.accept->is_accept = false;
-  a.accept->out.push_back({transition_type::EPSILON, 0, a.start});
-  a.accept->out.push_back({transition_type::EPSILON, 0, t});
-  t->is_accept = true;
+  arena[a.accept].is_accept = false;
+  arena[a.accept].out.push_back({transition_type::EPSILON, 0, a.start});
+  arena[a.accept].out.push_back({transition_type::EPSILON, 0, t});
+  arena[t].is_accept = true;
   return {s, t};
 }
 
@@ -138,24 +155,24 @@ nfa star_nfa(nfa a) {
 a → a* → t
 con transiciones EPSILON
 */
-nfa plus_nfa(nfa a) {
+nfa plus_nfa(nfa_arena &arena, nfa a) {
   // A+ = A seguido de A*
-  nfa a_star = star_nfa(a);
-  return concat_nfa(a, a_star);
+  nfa a_star = star_nfa(arena, a);
+  return concat_nfa(arena, a, a_star);
 }
 
 /*A? == A | ε
 . ↗ → ↘
 s →a→ t
 */
-nfa question_nfa(nfa a) {
-  auto s = std::make_shared<state>();
-  auto t = std::make_shared<state>();
-  s->out.push_back({transition_type::EPSILON, 0, a.start});
-  s->out.push_back({transition_type::EPSILON, 0, t});
-  a.accept->is_accept = false;
-  a.accept->out.push_back({transition_type::EPSILON, 0, t});
-  t->is_accept = true;
+nfa question_nfa(nfa_arena &arena, nfa a) {
+  uint32_t s = arena.new_state();
+  uint32_t t = arena.new_state();
+  arena[s].out.push_back({transition_type::EPSILON, 0, a.start});
+  arena[s].out.push_back({transition_type::EPSILON, 0, t});
+  arena[a.accept].is_accept = false;
+  arena[a.accept].out.push_back({transition_type::EPSILON, 0, t});
+  arena[t].is_accept = true;
   return {s, t};
 }
 
@@ -164,13 +181,13 @@ nfa question_nfa(nfa a) {
 s →char_2→t
 .. ↘ char_n ↗
 Agregar transicion de tipo CHAR para cada caracter de chars */
-nfa char_class_nfa(const std::set<char> &chars) {
-  auto s = std::make_shared<state>();
-  auto t = std::make_shared<state>();
+nfa char_class_nfa(nfa_arena &arena, const std::set<char> &chars) {
+  uint32_t s = arena.new_state();
+  uint32_t t = arena.new_state();
   for (char c : chars) {
-    s->out.push_back({transition_type::CHAR, c, t});
+    arena[s].out.push_back({transition_type::CHAR, c, t});
   }
-  t->is_accept = true;
+  arena[t].is_accept = true;
   return {s, t};
 }
 
@@ -179,12 +196,15 @@ nfa char_class_nfa(const std::set<char> &chars) {
 
 // Se encarga de parsear el patron y generar el NFA correspondiente siguiendo
 // la prioridad de (nomeacuerdoelnombre XD) y la construccion de Thompson.
+// Los estados se crean en el arena que se le pasa.
 class parser {
   const std::string &pattern;
+  nfa_arena &arena;
   size_t pos = 0;
 
  public:
-  parser(const std::string &pat) : pattern(pat) {}
+  parser(const std::string &pat, nfa_arena &_arena)
+      : pattern(pat), arena(_arena) {}
 
   // Punto de entrada: hace un parseo recursivo descendente :)
   nfa parse() {
@@ -206,7 +226,7 @@ class parser {
     while (pos < pattern.size() && pattern[pos] == '|') {
       pos++;
       nfa right = parse_term();
-      left = alt_nfa(left, right);
+      left = alt_nfa(arena, left, right);
     }
     return left;
   }
@@ -216,7 +236,7 @@ class parser {
     nfa result = parse_factor();
     while (pos < pattern.size() && pattern[pos] != ')' && pattern[pos] != '|') {
       nfa next = parse_factor();
-      result = concat_nfa(result, next);
+      result = concat_nfa(arena, result, next);
     }
     return result;
   }
@@ -227,13 +247,13 @@ class parser {
     while (pos < pattern.size()) {
       char op = pattern[pos];
       if (op == '*') {
-        base = star_nfa(base);
+        base = star_nfa(arena, base);
         pos++;
       } else if (op == '+') {
-        base = plus_nfa(base);
+        base = plus_nfa(arena, base);
         pos++;
       } else if (op == '?') {
-        base = question_nfa(base);
+        base = question_nfa(arena, base);
         pos++;
       } else
         break;
@@ -258,11 +278,11 @@ class parser {
     }
     if (c == '\\') {
       char escaped = advance();
-      return char_nfa(escaped);  // interpreta el carácter escapado literalmente
+      return char_nfa(arena, escaped);  // interpreta el carácter escapado literalmente
     }
     if (c == '.') {  // comodin
       pos++;
-      return any_nfa();
+      return any_nfa(arena);
     }
     if (c == '[') {  // clase de caracteres
       pos++;
@@ -286,18 +306,18 @@ class parser {
         }
       }
       if (pos >= pattern.size() || pattern[pos] != ']') {
-        throw std::runtime_error("Falta ']' en la posición " + to_string(pos));
+        throw std::runtime_error("Falta ']' en la posición " + std::to_string(pos));
       }
       pos++;
 
       // Aqui me trabe y no se bien como hacer la parte del ^,
       // pero para las regex de Hulk creo que no hace falta :)
 
-      return char_class_nfa(chars);
+      return char_class_nfa(arena, chars);
     }
     // caracter literal
     pos++;
-    return char_nfa(c);
+    return char_nfa(arena, c);
   }
 };
 
@@ -305,27 +325,27 @@ class parser {
 // ====================================
 
 // Añade un estado y recorre las transiciones epsilon
-void add_state(state_ptr s, std::set<state_ptr> &states) {
+void add_state(const nfa_arena &arena, uint32_t s, std::set<uint32_t> &states) {
   if (states.count(s)) return;
   states.insert(s);
-  for (auto &tr : s->out) {
+  for (auto &tr : arena[s].out) {
     if (tr.type == transition_type::EPSILON) {
-      add_state(tr.next, states);
+      add_state(arena, tr.next, states);
     }
   }
 }
 
 // Verifica si el NFA acepta todo el texto
-bool match(const nfa &nfa, const std::string &text) {
-  std::set<state_ptr> current;
-  add_state(nfa.start, current);
+bool match(const nfa_arena &arena, const nfa &nfa, const std::string &text) {
+  std::set<uint32_t> current;
+  add_state(arena, nfa.start, current);
   for (char c : text) {
-    std::set<state_ptr> next_states;
+    std::set<uint32_t> next_states;
     for (auto s : current) {
-      for (auto &tr : s->out) {
+      for (auto &tr : arena[s].out) {
         if ((tr.type == transition_type::CHAR && tr.c == c) ||
             tr.type == transition_type::ANY) {
-          add_state(tr.next, next_states);
+          add_state(arena, tr.next, next_states);
         }
       }
     }
@@ -333,8 +353,112 @@ bool match(const nfa &nfa, const std::string &text) {
   }
   // al llegar al final del texto, ver si es estado final valido
   for (auto s : current) {
-    if (s->is_accept) return true;
+    if (arena[s].is_accept) return true;
+  }
+  return false;
+}
+
+// ============== Simulación bit-paralela del NFA
+// ====================================
+
+/*  Los estados ya estan numerados de forma densa en el arena y el conjunto de
+    estados activos es un bitset de palabras de 64 bits. Las clausuras epsilon
+    se calculan una sola vez por estado, asi cada paso de la simulacion son
+    solo AND y OR de palabras completas, sin reservar memoria por caracter.
+
+    En la construccion de Thompson todas las transiciones que consumen de un
+    estado (CHAR, ANY o una clase) van al mismo destino, por lo que basta con:
+        consume[c]  estados con alguna transicion que acepta el byte c
+        follow[q]   clausura epsilon del destino de q
+    y un paso es: next = OR { follow[q] : q en (current AND consume[c]) }
+*/
+struct bit_nfa {
+  size_t words = 0;                    // palabras de 64 bits por conjunto
+  std::vector<uint64_t> start;         // clausura del estado inicial
+  std::vector<uint64_t> accept;        // estados de aceptacion
+  std::vector<uint64_t> consume;       // consume[c * words + w]
+  std::vector<uint64_t> follow;        // follow[q * words + w]
+};
+
+// Prepara las tablas del NFA para la simulacion con bitsets (usa todos los
+// estados del arena, conviene un arena por patron)
+bit_nfa compile(const nfa_arena &arena, const nfa &automaton) {
+  bit_nfa result;
+  const size_t n = arena.size(), words = (n + 63) / 64;
+  result.words = words;
+
+  auto set_bit = [](uint64_t *bits, uint32_t q) {
+    bits[q / 64] |= uint64_t(1) << (q % 64);
+  };
+
+  // clausuras epsilon de cada estado
+  std::vector<uint64_t> closure(n * words, 0);
+  for (uint32_t q = 0; q < n; ++q) {
+    std::stack<uint32_t> pending;
+    pending.push(q);
+    uint64_t *bits = &closure[q * words];
+    while (!pending.empty()) {
+      uint32_t cur = pending.top();
+      pending.pop();
+      if (bits[cur / 64] >> (cur % 64) & 1) continue;
+      set_bit(bits, cur);
+      for (auto &tr : arena[cur].out)
+        if (tr.type == transition_type::EPSILON) pending.push(tr.next);
+    }
+  }
+
+  result.start.assign(closure.begin() + automaton.start * words,
+                      closure.begin() + (automaton.start + 1) * words);
+  result.accept.assign(words, 0);
+  result.consume.assign(256 * words, 0);
+  result.follow.assign(n * words, 0);
+
+  for (uint32_t q = 0; q < n; ++q) {
+    if (arena[q].is_accept) set_bit(result.accept.data(), q);
+    for (auto &tr : arena[q].out) {
+      if (tr.type == transition_type::EPSILON) continue;
+      if (tr.type == transition_type::ANY) {
+        for (int c = 0; c < 256; ++c) set_bit(&result.consume[c * words], q);
+      } else {
+        set_bit(&result.consume[static_cast<unsigned char>(tr.c) * words], q);
+      }
+      std::copy(closure.begin() + tr.next * words,
+                closure.begin() + (tr.next + 1) * words,
+                result.follow.begin() + q * words);
+    }
+  }
+
+  return result;
+}
+
+// Verifica si el NFA acepta todo el texto, usando las tablas de compile()
+bool match(const bit_nfa &automaton, const std::string &text) {
+  const size_t words = automaton.words;
+  std::vector<uint64_t> current(automaton.start), next(words);
+
+  for (char c : text) {
+    const uint64_t *consume =
+        &automaton.consume[static_cast<unsigned char>(c) * words];
+    std::fill(next.begin(), next.end(), 0);
+    bool alive = false;
+
+    for (size_t w = 0; w < words; ++w) {
+      uint64_t active = current[w] & consume[w];
+      while (active) {
+        size_t q = w * 64 + __builtin_ctzll(active);
+        active &= active - 1;
+        const uint64_t *follow = &automaton.follow[q * words];
+        for (size_t k = 0; k < words; ++k) next[k] |= follow[k];
+        alive = true;
+      }
+    }
+
+    if (!alive) return false;
+    current.swap(next);
   }
+
+  for (size_t w = 0; w < words; ++w)
+    if (current[w] & automaton.accept[w]) return true;
   return false;
 }
 
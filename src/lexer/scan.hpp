@@ -0,0 +1,298 @@
+#ifndef HULK_SCAN_HPP
+#define HULK_SCAN_HPP 1
+
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#include <immintrin.h>
+#define HULK_SCAN_X86 1
+#endif
+
+#include "dfa.hpp"
+#include "dfa_tables.hpp"
+#include "tokens.hpp"
+
+namespace hulk {
+
+namespace lexer {
+
+/*  Caminos rapidos del lexer
+    Los espacios, los comentarios de linea y el cuerpo de los strings son la
+    mayor parte del codigo y en el DFA se recorren byte a byte. Aqui se buscan
+    16 (SSE2) o 32 (AVX2) bytes a la vez:
+        - skip_blanks:  primer byte que no es ' ', '\t' ni '\n',
+        - comment_end:  primer byte que no puede ir en un comentario // ,
+        - string_end:   primer byte que no puede ir dentro de un string
+                        (la comilla que lo cierra o un caracter invalido),
+        - count_lines:  cantidad de '\n' (popcount por bloque) y el ultimo,
+                        para actualizar linea/columna sin recorrer el lexema.
+    La version se elige una sola vez al arrancar (AVX2 si el procesador lo
+    tiene, si no SSE2, y la escalar fuera de x86).
+    Los conjuntos de bytes salen de las regex de regexs_tokens; los
+    static_assert de abajo comprueban que coinciden con el DFA generado.
+*/
+
+// [ \t]+ y [\n]+ (WHITESPACE y NEWLINE, ninguno llega al parser)
+constexpr bool is_blank(unsigned char c) {
+  return c == ' ' || c == '\t' || c == '\n';
+}
+
+// [\v-~] de la regex de los comentarios de linea ([ -\t] es un rango vacio)
+constexpr bool is_comment_body(unsigned char c) { return c >= '\v' && c <= '~'; }
+
+// [\t- ]|[#-~] de la regex de los strings
+constexpr bool is_string_body(unsigned char c) {
+  return (c >= '\t' && c <= ' ') || (c >= '#' && c <= '~');
+}
+
+// ======================== Comprobacion contra el DFA
+// ======================================
+
+// Desde s el DFA se queda en s con los bytes de body y muere con el resto
+// (salvo except, que se comprueba aparte)
+constexpr bool dfa_loops_on(const dfa_view &d, uint16_t s,
+                            bool (*body)(unsigned char), int except = -1) {
+  for (int c = 0; c < 256; ++c) {
+    if (c == except) continue;
+    uint16_t t = d.step(s, static_cast<unsigned char>(c));
+    if (body(static_cast<unsigned char>(c)) ? t != s : t != dfa_view::dead)
+      return false;
+  }
+  return true;
+}
+
+constexpr bool is_space_or_tab(unsigned char c) { return c == ' ' || c == '\t'; }
+constexpr bool is_newline(unsigned char c) { return c == '\n'; }
+constexpr bool is_nothing(unsigned char) { return false; }
+
+constexpr bool fast_paths_match_dfa() {
+  constexpr dfa_view d = tokens_dfa();
+
+  // espacios y saltos de linea: corridas que no se mezclan con otro token
+  for (unsigned char c : {' ', '\t'}) {
+    uint16_t s = d.step(d.start, c);
+    if (d.accept[s] != token_type::WHITESPACE ||
+        !dfa_loops_on(d, s, is_space_or_tab))
+      return false;
+  }
+  uint16_t nl = d.step(d.start, '\n');
+  if (d.accept[nl] != token_type::NEWLINE || !dfa_loops_on(d, nl, is_newline))
+    return false;
+
+  // "//" seguido de is_comment_body hasta el primer byte que no lo sea
+  uint16_t comment = d.step(d.step(d.start, '/'), '/');
+  if (d.accept[comment] != token_type::COMMENT ||
+      !dfa_loops_on(d, comment, is_comment_body))
+    return false;
+
+  // '"' seguido de is_string_body, y despues de la comilla final no sigue nada
+  uint16_t body = d.step(d.start, '"');
+  if (!dfa_loops_on(d, body, is_string_body, '"')) return false;
+  uint16_t close = d.step(body, '"');
+  return d.accept[close] == token_type::STRING &&
+         dfa_loops_on(d, close, is_nothing);
+}
+
+static_assert(fast_paths_match_dfa(),
+              "scan.hpp no coincide con las regex de regexs_tokens");
+
+// ======================== Kernels
+// ======================================
+
+struct line_count {
+  size_t lines = 0;
+  const char *last_newline = nullptr;  // nullptr si no hay ninguno
+};
+
+namespace scan_scalar {
+
+const char *skip_blanks(const char *p, const char *end) {
+  while (p < end && is_blank(*p)) ++p;
+  return p;
+}
+
+const char *comment_end(const char *p, const char *end) {
+  while (p < end && is_comment_body(*p)) ++p;
+  return p;
+}
+
+const char *string_end(const char *p, const char *end) {
+  while (p < end && is_string_body(*p)) ++p;
+  return p;
+}
+
+line_count count_lines(const char *p, const char *end) {
+  line_count result;
+  for (; p < end; ++p) {
+    if (*p == '\n') {
+      result.lines++;
+      result.last_newline = p;
+    }
+  }
+  return result;
+}
+
+}  // namespace scan_scalar
+
+#ifdef HULK_SCAN_X86
+
+// Las comparaciones de SSE2/AVX2 son con signo: los bytes >= 0x80 son
+// negativos y quedan fuera de todos los rangos de arriba
+namespace scan_sse2 {
+
+inline __m128i splat(char c) { return _mm_set1_epi8(c); }
+
+const char *skip_blanks(const char *p, const char *end) {
+  for (; p + 16 <= end; p += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    __m128i blank = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, splat(' ')), _mm_cmpeq_epi8(v, splat('\t'))),
+        _mm_cmpeq_epi8(v, splat('\n')));
+    unsigned stop = ~static_cast<unsigned>(_mm_movemask_epi8(blank)) & 0xFFFF;
+    if (stop) return p + __builtin_ctz(stop);
+  }
+  return scan_scalar::skip_blanks(p, end);
+}
+
+const char *comment_end(const char *p, const char *end) {
+  for (; p + 16 <= end; p += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    __m128i body = _mm_andnot_si128(_mm_cmpeq_epi8(v, splat(0x7F)),
+                                    _mm_cmpgt_epi8(v, splat('\v' - 1)));
+    unsigned stop = ~static_cast<unsigned>(_mm_movemask_epi8(body)) & 0xFFFF;
+    if (stop) return p + __builtin_ctz(stop);
+  }
+  return scan_scalar::comment_end(p, end);
+}
+
+const char *string_end(const char *p, const char *end) {
+  for (; p + 16 <= end; p += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    __m128i bad = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, splat('!')), _mm_cmpeq_epi8(v, splat('"'))),
+        _mm_cmpeq_epi8(v, splat(0x7F)));
+    __m128i body = _mm_andnot_si128(bad, _mm_cmpgt_epi8(v, splat('\t' - 1)));
+    unsigned stop = ~static_cast<unsigned>(_mm_movemask_epi8(body)) & 0xFFFF;
+    if (stop) return p + __builtin_ctz(stop);
+  }
+  return scan_scalar::string_end(p, end);
+}
+
+line_count count_lines(const char *p, const char *end) {
+  line_count result;
+  for (; p + 16 <= end; p += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    unsigned nl = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, splat('\n'))));
+    if (nl) {
+      result.lines += __builtin_popcount(nl);
+      result.last_newline = p + 31 - __builtin_clz(nl);
+    }
+  }
+  line_count tail = scan_scalar::count_lines(p, end);
+  result.lines += tail.lines;
+  if (tail.last_newline) result.last_newline = tail.last_newline;
+  return result;
+}
+
+}  // namespace scan_sse2
+
+namespace scan_avx2 {
+
+#define HULK_AVX2 __attribute__((target("avx2")))
+
+HULK_AVX2 inline __m256i splat(char c) { return _mm256_set1_epi8(c); }
+
+HULK_AVX2 const char *skip_blanks(const char *p, const char *end) {
+  for (; p + 32 <= end; p += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    __m256i blank = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, splat(' ')), _mm256_cmpeq_epi8(v, splat('\t'))),
+        _mm256_cmpeq_epi8(v, splat('\n')));
+    unsigned stop = ~static_cast<unsigned>(_mm256_movemask_epi8(blank));
+    if (stop) return p + __builtin_ctz(stop);
+  }
+  return scan_sse2::skip_blanks(p, end);
+}
+
+HULK_AVX2 const char *comment_end(const char *p, const char *end) {
+  for (; p + 32 <= end; p += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    __m256i body = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, splat(0x7F)),
+                                       _mm256_cmpgt_epi8(v, splat('\v' - 1)));
+    unsigned stop = ~static_cast<unsigned>(_mm256_movemask_epi8(body));
+    if (stop) return p + __builtin_ctz(stop);
+  }
+  return scan_sse2::comment_end(p, end);
+}
+
+HULK_AVX2 const char *string_end(const char *p, const char *end) {
+  for (; p + 32 <= end; p += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    __m256i bad = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, splat('!')), _mm256_cmpeq_epi8(v, splat('"'))),
+        _mm256_cmpeq_epi8(v, splat(0x7F)));
+    __m256i body = _mm256_andnot_si256(bad, _mm256_cmpgt_epi8(v, splat('\t' - 1)));
+    unsigned stop = ~static_cast<unsigned>(_mm256_movemask_epi8(body));
+    if (stop) return p + __builtin_ctz(stop);
+  }
+  return scan_sse2::string_end(p, end);
+}
+
+HULK_AVX2 line_count count_lines(const char *p, const char *end) {
+  line_count result;
+  for (; p + 32 <= end; p += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    unsigned nl = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, splat('\n'))));
+    if (nl) {
+      result.lines += __builtin_popcount(nl);
+      result.last_newline = p + 31 - __builtin_clz(nl);
+    }
+  }
+  line_count tail = scan_sse2::count_lines(p, end);
+  result.lines += tail.lines;
+  if (tail.last_newline) result.last_newline = tail.last_newline;
+  return result;
+}
+
+#undef HULK_AVX2
+
+}  // namespace scan_avx2
+
+#endif  // HULK_SCAN_X86
+
+// ======================== Seleccion en tiempo de ejecucion
+// ======================================
+
+struct scan_kernels {
+  const char *(*skip_blanks)(const char *, const char *);
+  const char *(*comment_end)(const char *, const char *);
+  const char *(*string_end)(const char *, const char *);
+  line_count (*count_lines)(const char *, const char *);
+  const char *name;
+};
+
+scan_kernels select_scan_kernels() {
+#ifdef HULK_SCAN_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return {scan_avx2::skip_blanks, scan_avx2::comment_end,
+            scan_avx2::string_end, scan_avx2::count_lines, "avx2"};
+  return {scan_sse2::skip_blanks, scan_sse2::comment_end,
+          scan_sse2::string_end, scan_sse2::count_lines, "sse2"};
+#else
+  return {scan_scalar::skip_blanks, scan_scalar::comment_end,
+          scan_scalar::string_end, scan_scalar::count_lines, "scalar"};
+#endif
+}
+
+const scan_kernels &scanner() {
+  static const scan_kernels kernels = select_scan_kernels();
+  return kernels;
+}
+
+}  // namespace lexer
+
+}  // namespace hulk
+
+#endif  // HULK_SCAN_HPP
@@ -0,0 +1,62 @@
+#ifndef HULK_SOURCE_HPP
+#define HULK_SOURCE_HPP 1
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "../internal/internal_uncopyable.hpp"
+
+namespace hulk {
+
+namespace lexer {
+
+// Archivo de codigo fuente mapeado en memoria (solo lectura).
+// Los tokens guardan string_view sobre este buffer en vez de copiar cada
+// lexema, asi que tiene que vivir mientras se usen los tokens o el AST.
+struct source_file : private internal::uncopyable {
+  explicit source_file(const std::string &path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open file");
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+      close(fd);
+      throw std::runtime_error("Failed to open file");
+    }
+
+    size = static_cast<size_t>(info.st_size);
+    if (size > 0) {  // mmap no acepta longitud 0
+      void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Failed to map file");
+      }
+      data = static_cast<const char *>(mapping);
+    }
+    close(fd);
+  }
+
+  ~source_file() {
+    if (data) munmap(const_cast<char *>(data), size);
+  }
+
+  std::string_view text() const { return {data, size}; }
+
+ private:
+  const char *data = nullptr;
+  size_t size = 0;
+};
+
+}  // namespace lexer
+
+}  // namespace hulk
+
+#endif  // HULK_SOURCE_HPP
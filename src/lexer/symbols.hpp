@@ -0,0 +1,57 @@
+#ifndef HULK_SYMBOLS_HPP
+#define HULK_SYMBOLS_HPP 1
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace hulk {
+
+namespace lexer {
+
+// Identificador interno de un nombre: dos nombres iguales tienen el mismo
+// symbol, asi las fases siguientes comparan y hashean enteros en vez de strings
+using symbol = uint32_t;
+
+// El string vacio siempre es el symbol 0 (tokens sin lexema, tipos no
+// anotados, ...)
+constexpr symbol empty_symbol = 0;
+
+// Tabla global de nombres, la llena el lexer con los identificadores
+struct symbol_table {
+  symbol_table() { intern(""); }
+
+  symbol intern(std::string_view text) {
+    auto it = ids.find(text);
+    if (it != ids.end()) return it->second;
+
+    // deque: los strings no se mueven al crecer, las vistas siguen validas
+    names.emplace_back(text);
+    symbol id = static_cast<symbol>(names.size() - 1);
+    ids.emplace(names.back(), id);
+    return id;
+  }
+
+  std::string_view name(symbol id) const { return names[id]; }
+
+  size_t size() const { return names.size(); }
+
+ private:
+  std::deque<std::string> names;
+  std::unordered_map<std::string_view, symbol> ids;
+};
+
+symbol_table &symbols() {
+  static symbol_table table;
+  return table;
+}
+
+symbol intern(std::string_view text) { return symbols().intern(text); }
+
+}  // namespace lexer
+
+}  // namespace hulk
+
+#endif  // HULK_SYMBOLS_HPP
@@ -0,0 +1,127 @@
+#ifndef HULK_TOKEN_ARRAY_HPP
+#define HULK_TOKEN_ARRAY_HPP 1
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../internal/internal_error.hpp"
+#include "lexer.hpp"
+#include "tokens.hpp"
+
+namespace hulk {
+
+namespace lexer {
+
+/*  Tokens de un archivo completo en arreglos paralelos
+    Por token se guarda solo el tipo (1 byte), donde empieza y el largo del
+    lexema (offsets de 32 bits sobre el codigo fuente) y un valor de 32 bits:
+        - IDENTIFIER: su symbol,
+        - NUMBER:     indice en numbers,
+        - el resto:   0.
+    El valor de un string es su lexema sin las comillas, asi que no se copia.
+    Linea y columna salen de los offsets con line_starts (busqueda binaria).
+    Se accede por indice; get(i) arma el token completo para quien lo
+    necesite guardar (el AST).
+*/
+
+struct token_array {
+  std::string_view source;
+  std::vector<uint8_t> kinds;
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> lengths;
+  std::vector<uint32_t> values;
+  std::vector<double> numbers;
+  std::vector<uint32_t> line_starts = {0};  // offset de cada linea
+
+  size_t size() const { return kinds.size(); }
+
+  token_type type(size_t i) const { return static_cast<token_type>(kinds[i]); }
+
+  std::string_view lexeme(size_t i) const {
+    return source.substr(offsets[i], lengths[i]);
+  }
+
+  symbol id(size_t i) const {
+    return type(i) == IDENTIFIER ? values[i] : empty_symbol;
+  }
+
+  literal value(size_t i) const {
+    switch (type(i)) {
+      case NUMBER:
+        return numbers[values[i]];
+      case STRING:
+        return std::string(lexeme(i).substr(1, lengths[i] - 2));
+      case TRUE:
+        return true;
+      case FALSE:
+        return false;
+      default:
+        return nullptr;
+    }
+  }
+
+  // Linea y columna despues del lexema (como en token)
+  std::pair<unsigned int, unsigned int> location(size_t i) const {
+    uint32_t end = offsets[i] + lengths[i];
+    auto line = std::upper_bound(line_starts.begin(), line_starts.end(), end) - 1;
+    return {static_cast<unsigned int>(line - line_starts.begin() + 1),
+            end - *line + 1};
+  }
+
+  token get(size_t i) const {
+    auto [line, column] = location(i);
+    return token(type(i), lexeme(i), value(i), line, column, id(i));
+  }
+
+  void push(token_type type, uint32_t offset, uint32_t length,
+            uint32_t value) {
+    kinds.push_back(static_cast<uint8_t>(type));
+    offsets.push_back(offset);
+    lengths.push_back(length);
+    values.push_back(value);
+  }
+};
+
+static_assert(token_type::UNKNOWN <= UINT8_MAX,
+              "token_type no cabe en los kinds de token_array");
+
+// Igual que lex pero guarda los tokens en un token_array (input tiene que
+// ser de menos de 4 GB)
+token_array lex_compact(std::string_view input) {
+  token_array tokens;
+  tokens.source = input;
+  for (size_t nl = input.find('\n'); nl != std::string_view::npos;
+       nl = input.find('\n', nl + 1))
+    tokens.line_starts.push_back(static_cast<uint32_t>(nl + 1));
+
+  lex_position at;
+  token next;
+  lex_status status;
+  while ((status = lex_token(input, input.size(), at, true, next)) !=
+         lex_status::END) {
+    if (status == lex_status::ERROR) unexpected_character(next);
+    uint32_t value = 0;
+    if (next.type == IDENTIFIER) {
+      value = next.id;
+    } else if (next.type == NUMBER) {
+      value = static_cast<uint32_t>(tokens.numbers.size());
+      tokens.numbers.push_back(std::get<double>(next.value));
+    }
+    tokens.push(next.type, static_cast<uint32_t>(next.lexeme.data() - input.data()),
+                static_cast<uint32_t>(next.lexeme.size()), value);
+  }
+
+  tokens.push(END_OF_FILE, static_cast<uint32_t>(input.size()), 0, 0);
+  return tokens;
+}
+
+}  // namespace lexer
+
+}  // namespace hulk
+
+#endif  // HULK_TOKEN_ARRAY_HPP
@@ -0,0 +1,107 @@
+#ifndef HULK_TOKEN_STREAM_HPP
+#define HULK_TOKEN_STREAM_HPP 1
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+#include "../internal/internal_error.hpp"
+#include "../internal/internal_uncopyable.hpp"
+#include "lexer.hpp"
+#include "token_array.hpp"
+#include "tokens.hpp"
+
+namespace hulk {
+
+namespace lexer {
+
+// Tokens de input a pedido: cada token se lexea cuando el parser llega a el
+// y solo se guardan los ultimos en un buffer circular, asi la memoria de los
+// tokens no crece con el archivo. Igual que con lex, input tiene que vivir
+// mientras se usen los tokens.
+// Tambien puede leer de un token_array ya lexeado: el token numero current
+// se arma a partir de los arreglos cuando el parser llega a el.
+struct token_stream : private internal::uncopyable {
+  // el parser mira el token actual y el anterior, el resto es margen
+  static constexpr size_t lookahead = 4;
+
+  explicit token_stream(std::string_view _input) : input(_input) { fill(); }
+
+  explicit token_stream(const token_array &_array) : array(&_array) { fill(); }
+
+  // solo los tokens [begin, end) del arreglo, seguidos de END_OF_FILE
+  token_stream(const token_array &_array, size_t begin, size_t end)
+      : array(&_array), current(begin), stop(end) {
+    fill();
+  }
+
+  // token actual (END_OF_FILE al terminar)
+  const token &peek() const { return ring[current % lookahead]; }
+
+  // ultimo token consumido
+  const token &previous() const { return ring[(current - 1) % lookahead]; }
+
+  // consume el token actual (salvo END_OF_FILE) y lo devuelve
+  const token &next() {
+    if (!at_end()) {
+      ++current;
+      fill();
+    }
+    return previous();
+  }
+
+  bool at_end() const { return peek().type == token_type::END_OF_FILE; }
+
+  // con token_array: indice del token actual y salto a otro indice
+  // (previous() queda en el token anterior a index; con index 0 no hay)
+  size_t position() const { return current; }
+
+  void seek(size_t index) {
+    current = index;
+    if (index > 0) {
+      --current;
+      fill();
+      ++current;
+    }
+    fill();
+  }
+
+ private:
+  std::string_view input;
+  const token_array *array = nullptr;
+  lex_position at;
+  std::array<token, lookahead> ring;
+  size_t current = 0;
+  size_t stop = SIZE_MAX;
+
+  // lexea el token numero current
+  void fill() {
+    token &slot = ring[current % lookahead];
+    if (array) {  // el ultimo de un token_array siempre es END_OF_FILE
+      if (current < stop) {
+        slot = array->get(current);
+      } else {
+        auto [line, column] = array->location(current);
+        slot = token(token_type::END_OF_FILE, "", nullptr, line, column);
+      }
+      return;
+    }
+    switch (lex_token(input, input.size(), at, true, slot)) {
+      case lex_status::TOKEN:
+        return;
+      case lex_status::END:
+        slot = token(token_type::END_OF_FILE, "", nullptr, at.line, at.column);
+        return;
+      case lex_status::ERROR:  // el parser recibe el UNKNOWN
+        unexpected_character(slot);
+        return;
+    }
+  }
+};
+
+}  // namespace lexer
+
+}  // namespace hulk
+
+#endif  // HULK_TOKEN_STREAM_HPP
@@ -2,10 +2,13 @@
 #define HULK_TOKENS_HPP 1
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include "symbols.hpp"
+
 namespace hulk {
 
 namespace lexer {
@@ -234,16 +237,24 @@ std::string token_type_to_string(token_type type) {
 using literal = std::variant<std::nullptr_t, std::string, double, bool>;
 
 // Token simple con: Type, Value, Line y Column
+// El lexema es una vista sobre el codigo fuente, que tiene que vivir mientras
+// se usen los tokens (y el AST que los guarda). Los identificadores ademas
+// traen su symbol en id.
 struct token {
   token_type type;
-  std::string lexeme;
+  symbol id = empty_symbol;
+  std::string_view lexeme;
   literal value;
   unsigned int line, column;
   
-  token() {}
-  token(const token_type _type, std::string _lexeme,
-                 const literal &_value, int _line, int _column)
+  // Vacio (un tipo que no se escribio): UNKNOWN en 0:0, nunca basura, porque
+  // tambien se guarda en la imagen de la biblioteca
+  token() : type(UNKNOWN), line(0), column(0) {}
+  token(const token_type _type, std::string_view _lexeme,
+                 const literal &_value, int _line, int _column,
+                 symbol _id = empty_symbol)
       : type(_type),
+        id(_id),
         lexeme(_lexeme),
         value(std::move(_value)),
         line(_line),
@@ -255,11 +266,19 @@ struct token {
     return {line, column};
   }
 
-  std::string get_lexeme() const { return lexeme; }
+  std::string get_lexeme() const { return std::string(lexeme); }
+
+  // Para lexemas que no vienen del codigo fuente (p. ej. los tipos
+  // inferidos): la vista apunta a la copia guardada en la tabla de symbols
+  void set_lexeme(std::string_view _lexeme) {
+    id = intern(_lexeme);
+    lexeme = symbols().name(id);
+  }
+
   literal get_literal() const { return value; }
 
   std::string to_string() const {
-    return token_type_to_string(type) + " " + lexeme + " at " +
+    return token_type_to_string(type) + " " + get_lexeme() + " at " +
            "[line = " + std::to_string(line) +
            ", column = " + std::to_string(column) + "]";
   }
@@ -277,36 +296,10 @@ static const std::vector<std::pair<std::string, token_type>> regexs_tokens = {
     {"\"([\t- ]|[#-~])*\"",
      token_type::STRING},  // falta evitar que se ponga \n y \" en .*
     {"'.'", token_type::CHAR},
-    {"Null", token_type::T_NULL},
-
     {"[0-9]*([.][0-9]+)?", token_type::NUMBER},
 
-    // Palabras clave
-    {"if", token_type::KW_IF},
-    {"elif", token_type::KW_ELIF},
-    {"else", token_type::KW_ELSE},
-    {"while", token_type::KW_WHILE},
-    {"for", token_type::KW_FOR},
-    {"function", token_type::KW_FUNCTION},
-    {"let", token_type::KW_LET},
-    {"in", token_type::KW_IN},
-    {"type", token_type::KW_TYPE},
-    {"new", token_type::KW_NEW},
-    {"inherits", token_type::KW_INHERITS},
-    // {"base", token_type::KW_BASE},
-    {"protocol", token_type::KW_PROTOCOL},
-    {"extends", token_type::KW_EXTENDS},
-
-    {"true", token_type::TRUE},
-    {"false", token_type::FALSE},
-    // {"Object", token_type::T_OBJECT},
-    // {"Number", token_type::T_NUMBER},
-    // {"Boolean", token_type::T_BOOLEAN},
-    // {"String", token_type::T_STRING},
-    // {"Char", token_type::T_CHAR},
-
-    {"is", token_type::OP_IS},
-    {"as", token_type::OP_AS},
+    // Las palabras clave (if, let, true, Null, is, ...) las reconoce
+    // IDENTIFIER y despues se clasifican con classify_word (keywords.hpp)
 
     // Operadores (mayores primero)
     {"[*][*]", token_type::OP_EXPONENT},
@@ -353,7 +346,7 @@ static const std::vector<std::pair<std::string, token_type>> regexs_tokens = {
     {"[[]", token_type::LBRACKET},
     {"]", token_type::RBRACKET},
 
-    // Identificadores al final
+    // Identificadores (y palabras clave) al final
     {"[a-zA-Z]+[a-zA-Z0-9_]*", token_type::IDENTIFIER}};
 
 }  // namespace lexer
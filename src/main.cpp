@@ -1,6 +1,4 @@
-#include <fstream>
 #include <iostream>
-#include <sstream>
 #include <string>
 #include <vector>
 
@@ -8,37 +6,9 @@
 
 using namespace hulk;
 
-std::string read_source_code(const std::string& source_path) {
-  const std::ifstream input(source_path, std::ios_base::binary);
-
-  if (input.fail()) {
-    throw std::runtime_error("Failed to open file");
-  }
-
-  std::stringstream buffer;
-  buffer << input.rdbuf();
-
-  return buffer.str();
-}
-
-std::string read_lib_code() {
-  const std::ifstream input("lib.hulk", std::ios_base::binary);
-
-  if (input.fail()) {
-    throw std::runtime_error("Failed to open file");
-  }
-
-  std::stringstream buffer;
-  buffer << input.rdbuf();
-
-  return buffer.str();
-}
-
 int main(const int argc, char** argv) {
-  auto lib_code = read_lib_code();
-  auto source_code = read_source_code(argv[1]);
-
-  // source_code = lib_code + source_code;
+  const lexer::source_file source(argv[1]);
+  const auto source_code = source.text();
 
   if (source_code.empty()) {
     std::cout << "Source code must not be empty" << std::endl;
@@ -47,24 +17,34 @@ int main(const int argc, char** argv) {
 
   std::cerr << "START COMPILATION" << "\n";
 
-  const auto& tokens = lexer::lex(source_code);
+  // el lexer corre a medida que el parser pide tokens; con --parallel se
+  // lexea todo antes y las declaraciones se parsean en varios hilos
+  const bool parallel = argc > 2 && std::string(argv[2]) == "--parallel";
+  auto parse = [&source_code, parallel]() {
+    if (parallel)
+      return parser::parse_parallel(source_code);
+    lexer::token_stream tokens(source_code);
+    return parser::parser(tokens).parse();
+  };
+  auto ast = parse();
 
-  if (internal::error_found) return -1;
-   
   std::cerr << "LEXED" << "\n";
 
-  auto parser = parser::parser(tokens);
-  const auto& ast = parser.parse();
-
   if (internal::error_found) return -1;
 
   std::cerr << "PARSED" << "\n";
 
-  if (semantic::analyze(ast))
+  // lib.hulk sale de la imagen cacheada en hulk/ mientras no cambie; se carga
+  // despues de parsear para saber que nombres usa el programa
+  semantic::prelude lib("lib.hulk", "hulk/lib.cache");
+
+  if (semantic::analyze(ast, &lib))
     return -1;
 
   std::cerr << "ANALIZED" << "\n";
 
+  lib.link(ast);
+
   code_generator::code_generator codegen;
   if (codegen.generate_code(ast))
     return -1;
@@ -0,0 +1,313 @@
+// Genera ll1_tables.hpp con la tabla LL(1) de grammar_LL1.txt, para que
+// ll1_parser no tenga que calcular nada al arrancar.
+// Uso: ll1_generator <gramatica> <salida>   (lo llama el Makefile cuando
+// cambia la gramatica)
+
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../lexer/tokens.hpp"
+
+using namespace hulk::lexer;
+
+// Simbolos: [0, terminals) son token_type, despues los no terminales y
+// despues las acciones
+constexpr int terminals = token_type::UNKNOWN + 1;
+
+struct grammar {
+  std::vector<std::string> nonterminals;  // el primero es el inicial
+  std::vector<std::string> actions;
+  std::vector<int> lhs;                   // por produccion
+  std::vector<std::vector<int>> rhs;      // por produccion
+
+  int nonterminal(int symbol) const { return symbol - terminals; }
+  bool is_terminal(int symbol) const { return symbol < terminals; }
+  bool is_nonterminal(int symbol) const {
+    return symbol >= terminals &&
+           symbol < terminals + static_cast<int>(nonterminals.size());
+  }
+};
+
+[[noreturn]] void fail(const std::string &message) {
+  std::cerr << "ll1_generator: " << message << std::endl;
+  exit(1);
+}
+
+// Palabras de la gramatica sin los comentarios (// hasta fin de linea)
+std::vector<std::string> words(std::istream &in) {
+  std::vector<std::string> result;
+  std::string line, word;
+  while (std::getline(in, line)) {
+    line = line.substr(0, line.find("//"));
+    std::istringstream split(line);
+    while (split >> word) result.push_back(word);
+  }
+  return result;
+}
+
+grammar read_grammar(std::istream &in) {
+  const std::vector<std::string> w = words(in);
+
+  // primera pasada: los no terminales son los que estan antes de ->
+  std::map<std::string, int> nonterminal;
+  grammar g;
+  for (size_t i = 0; i + 1 < w.size(); ++i)
+    if (w[i + 1] == "->" && !nonterminal.count(w[i])) {
+      nonterminal[w[i]] = terminals + static_cast<int>(g.nonterminals.size());
+      g.nonterminals.push_back(w[i]);
+    }
+  if (g.nonterminals.empty()) fail("empty grammar");
+
+  std::map<std::string, int> terminal;
+  for (int t = 0; t < terminals; ++t)
+    terminal[token_type_to_string(static_cast<token_type>(t))] = t;
+
+  std::map<std::string, int> action;
+  auto symbol = [&](const std::string &name) {
+    if (name[0] == '#') {
+      auto [it, added] = action.emplace(name.substr(1), action.size());
+      if (added) g.actions.push_back(name.substr(1));
+      return -1 - it->second;  // se corrige cuando se sabe cuantos hay
+    }
+    if (nonterminal.count(name)) return nonterminal[name];
+    if (terminal.count(name)) return terminal[name];
+    fail("unknown symbol '" + name + "'");
+  };
+
+  // segunda pasada: producciones
+  int current = -1;
+  for (size_t i = 0; i < w.size(); ++i) {
+    if (i + 1 < w.size() && w[i + 1] == "->") {
+      current = nonterminal[w[i]];
+      g.lhs.push_back(current);
+      g.rhs.emplace_back();
+      ++i;
+    } else if (w[i] == "|") {
+      if (current < 0) fail("'|' outside of a rule");
+      g.lhs.push_back(current);
+      g.rhs.emplace_back();
+    } else if (w[i] != "e") {
+      if (current < 0) fail("symbol '" + w[i] + "' outside of a rule");
+      g.rhs.back().push_back(symbol(w[i]));
+    }
+  }
+
+  const int first_action = terminals + static_cast<int>(g.nonterminals.size());
+  for (auto &production : g.rhs)
+    for (int &s : production)
+      if (s < 0) s = first_action + (-1 - s);
+  return g;
+}
+
+// ======================== FIRST y FOLLOW
+// ======================================
+
+struct analysis {
+  std::vector<std::set<int>> first, follow;  // por no terminal
+  std::vector<bool> nullable;
+};
+
+// FIRST de una secuencia; nullable queda en true si puede ser vacia
+std::set<int> first_of(const grammar &g, const analysis &a,
+                       std::vector<int>::const_iterator begin,
+                       std::vector<int>::const_iterator end, bool &nullable) {
+  std::set<int> result;
+  nullable = true;
+  for (auto it = begin; it != end && nullable; ++it) {
+    if (g.is_terminal(*it)) {
+      result.insert(*it);
+      nullable = false;
+    } else if (g.is_nonterminal(*it)) {
+      const auto &f = a.first[g.nonterminal(*it)];
+      result.insert(f.begin(), f.end());
+      nullable = a.nullable[g.nonterminal(*it)];
+    }  // las acciones no consumen nada
+  }
+  return result;
+}
+
+analysis analyze(const grammar &g) {
+  const size_t n = g.nonterminals.size();
+  analysis a{std::vector<std::set<int>>(n), std::vector<std::set<int>>(n),
+             std::vector<bool>(n, false)};
+
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (size_t p = 0; p < g.rhs.size(); ++p) {
+      const int A = g.nonterminal(g.lhs[p]);
+      bool nullable;
+      auto f = first_of(g, a, g.rhs[p].begin(), g.rhs[p].end(), nullable);
+      size_t before = a.first[A].size();
+      a.first[A].insert(f.begin(), f.end());
+      if (a.first[A].size() != before) changed = true;
+      if (nullable && !a.nullable[A]) a.nullable[A] = changed = true;
+    }
+  }
+
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (size_t p = 0; p < g.rhs.size(); ++p) {
+      const auto &rhs = g.rhs[p];
+      for (auto it = rhs.begin(); it != rhs.end(); ++it) {
+        if (!g.is_nonterminal(*it)) continue;
+        auto &follow = a.follow[g.nonterminal(*it)];
+        size_t before = follow.size();
+        bool nullable;
+        auto f = first_of(g, a, it + 1, rhs.end(), nullable);
+        follow.insert(f.begin(), f.end());
+        if (nullable) {
+          const auto &parent = a.follow[g.nonterminal(g.lhs[p])];
+          follow.insert(parent.begin(), parent.end());
+        }
+        if (follow.size() != before) changed = true;
+      }
+    }
+  }
+  return a;
+}
+
+// ======================== Tabla
+// ======================================
+
+constexpr int no_production = 255;
+
+// table[A * terminals + t]: produccion para expandir A viendo t. Si una
+// produccion entra por FIRST y otra solo por FOLLOW (la vacia) gana la
+// primera: el parser consume el token como hace el recursivo.
+std::vector<int> build_table(const grammar &g, const analysis &a) {
+  if (g.rhs.size() >= no_production) fail("too many productions");
+
+  std::vector<int> table(g.nonterminals.size() * terminals, no_production);
+  std::vector<bool> by_first(table.size(), false);
+  int resolved = 0;
+
+  auto set = [&](int A, int t, int p, bool first) {
+    size_t cell = static_cast<size_t>(A) * terminals + t;
+    if (table[cell] != no_production) {
+      if (by_first[cell] == first)
+        fail("conflict in " + g.nonterminals[A] + " on " +
+             token_type_to_string(static_cast<token_type>(t)));
+      ++resolved;
+      if (!first) return;
+    }
+    table[cell] = p;
+    by_first[cell] = first;
+  };
+
+  for (size_t p = 0; p < g.rhs.size(); ++p) {
+    const int A = g.nonterminal(g.lhs[p]);
+    bool nullable;
+    for (int t : first_of(g, a, g.rhs[p].begin(), g.rhs[p].end(), nullable))
+      set(A, t, static_cast<int>(p), true);
+    if (nullable)
+      for (int t : a.follow[A]) set(A, t, static_cast<int>(p), false);
+  }
+
+  std::cerr << "ll1_generator: " << g.nonterminals.size() << " nonterminals, "
+            << g.rhs.size() << " productions, " << resolved
+            << " conflicts resolved in favour of consuming the token"
+            << std::endl;
+  return table;
+}
+
+// ======================== Salida
+// ======================================
+
+std::string upper(std::string name) {
+  for (char &c : name) c = static_cast<char>(std::toupper(c));
+  return name;
+}
+
+template <class T>
+void write_array(std::ostream &out, const std::vector<T> &data,
+                 size_t per_line) {
+  for (size_t i = 0; i < data.size(); ++i) {
+    if (i % per_line == 0) out << "\n    ";
+    out << +data[i] << ",";
+  }
+  out << "\n";
+}
+
+void write_tables(std::ostream &out, const grammar &g,
+                  const std::vector<int> &table) {
+  const size_t n = g.nonterminals.size();
+
+  std::vector<int> rhs_start = {0}, rhs;
+  for (const auto &production : g.rhs) {
+    rhs.insert(rhs.end(), production.begin(), production.end());
+    rhs_start.push_back(static_cast<int>(rhs.size()));
+  }
+
+  out << "// Generado por ll1_generator.cpp a partir de grammar_LL1.txt, no "
+         "editar.\n"
+      << "#ifndef HULK_LL1_TABLES_HPP\n"
+      << "#define HULK_LL1_TABLES_HPP 1\n\n"
+      << "#include <cstdint>\n\n"
+      << "namespace hulk {\n\n"
+      << "namespace parser {\n\n"
+      << "namespace ll1 {\n\n"
+      << "// " << terminals << " terminales, " << n << " no terminales, "
+      << g.rhs.size() << " producciones\n"
+      << "constexpr uint16_t terminals = " << terminals << ";\n"
+      << "constexpr uint16_t nonterminals = " << n << ";\n"
+      << "constexpr uint16_t first_action = " << terminals + n << ";\n"
+      << "constexpr uint16_t start = " << terminals << ";  // "
+      << g.nonterminals[0] << "\n"
+      << "constexpr uint8_t no_production = " << no_production << ";\n\n";
+
+  out << "enum class action : uint16_t {\n";
+  for (const auto &a : g.actions) out << "  " << upper(a) << ",\n";
+  out << "};\n\n";
+
+  out << "constexpr const char *nonterminal_names[" << n << "] = {\n";
+  for (const auto &name : g.nonterminals) out << "    \"" << name << "\",\n";
+  out << "};\n\n";
+
+  out << "// lado derecho de la produccion p: rhs[rhs_start[p], rhs_start[p + 1])\n"
+      << "constexpr uint16_t rhs_start[" << rhs_start.size() << "] = {";
+  write_array(out, rhs_start, 16);
+  out << "};\n\n"
+      << "constexpr uint16_t rhs[" << rhs.size() << "] = {";
+  write_array(out, rhs, 16);
+  out << "};\n\n";
+
+  out << "// produccion para (no terminal, token) o no_production\n"
+      << "constexpr uint8_t table[" << n << " * " << terminals << "] = {";
+  write_array(out, table, terminals);
+  out << "};\n\n"
+      << "}  // namespace ll1\n\n"
+      << "}  // namespace parser\n\n"
+      << "}  // namespace hulk\n\n"
+      << "#endif  // HULK_LL1_TABLES_HPP\n";
+}
+
+int main(const int argc, char **argv) {
+  if (argc < 3) {
+    std::cerr << "usage: " << argv[0] << " <grammar> <output>" << std::endl;
+    return 1;
+  }
+
+  std::ifstream in(argv[1]);
+  if (in.fail()) {
+    std::cerr << "Failed to open " << argv[1] << std::endl;
+    return 1;
+  }
+
+  grammar g = read_grammar(in);
+  std::vector<int> table = build_table(g, analyze(g));
+
+  std::ofstream out(argv[2]);
+  if (out.fail()) {
+    std::cerr << "Failed to open " << argv[2] << std::endl;
+    return 1;
+  }
+  write_tables(out, g, table);
+  return 0;
+}
@@ -0,0 +1,395 @@
+#ifndef HULK_LL1_PARSER_HPP
+#define HULK_LL1_PARSER_HPP 1
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../ast/ast"
+#include "../ast/enums"
+#include "../internal/internal_error"
+#include "../lexer/token_stream"
+#include "../lexer/tokens"
+#include "ll1_tables"
+#include "parser"
+
+namespace hulk {
+
+namespace parser {
+
+// Parser LL(1) dirigido por la tabla que ll1_generator arma a partir de
+// grammar_LL1.txt. En vez de una funcion por regla tiene una pila de simbolos
+// explicita, asi que la profundidad de anidamiento no gasta pila de C++. Las
+// acciones de la gramatica arman el mismo ast::program que parser::parser
+// usando pilas de valores; #mark guarda el tamano de cada pila para saber
+// donde empiezan las listas (argumentos, parametros, miembros, ...).
+// A diferencia del recursivo no se recupera: se detiene en el primer error
+// de sintaxis.
+struct ll1_parser {
+  explicit ll1_parser(lexer::token_stream &_tokens) : tokens(_tokens) {}
+
+  ast::program parse() {
+    try {
+      run();
+    } catch (const parse_error &) {
+      // ya se reporto, se devuelve lo que se llego a armar
+    }
+    return ast::program(std::move(nodes), std::move(statements), main_expr);
+  }
+
+ private:
+  using TT = lexer::token_type;
+  using action = ll1::action;
+
+  lexer::token_stream &tokens;
+  ast::ast_arena nodes;
+
+  std::vector<ast::stmt_ptr> statements;
+  ast::expr_ptr main_expr = nullptr;
+
+  struct mark {
+    size_t toks, exprs, params, fields, functions;
+  };
+
+  std::vector<uint16_t> symbols;
+  std::vector<lexer::token> toks;
+  std::vector<ast::expr_ptr> exprs;
+  std::vector<ast::parameter> params;
+  std::vector<ast::field_stmt_ptr> fields;
+  std::vector<ast::function_stmt_ptr> functions;
+  std::vector<std::optional<ast::super_item_ptr>> supers;
+  std::vector<mark> marks;
+
+  void run() {
+    symbols.push_back(ll1::start);
+    while (!symbols.empty()) {
+      const uint16_t symbol = symbols.back();
+      symbols.pop_back();
+
+      if (symbol < ll1::terminals) {
+        if (tokens.peek().get_type() != symbol)
+          throw error(tokens.peek(), "Expected " + lexer::token_type_to_string(static_cast<TT>(symbol)) + ".");
+        tokens.next();
+      } else if (symbol < ll1::first_action) {
+        const uint16_t nonterminal = symbol - ll1::terminals;
+        const uint8_t production = ll1::table[nonterminal * ll1::terminals + tokens.peek().get_type()];
+        if (production == ll1::no_production)
+          throw error(tokens.peek(), expected(nonterminal));
+        // el lado derecho se apila al reves para que el primero quede arriba
+        for (uint16_t i = ll1::rhs_start[production + 1]; i > ll1::rhs_start[production]; --i)
+          symbols.push_back(ll1::rhs[i - 1]);
+      } else {
+        execute(static_cast<action>(symbol - ll1::first_action));
+      }
+    }
+  }
+
+  void execute(const action a) {
+    switch (a) {
+      case action::MAIN: {
+        ast::expr_ptr expr = pop(exprs);
+        if (main_expr) {
+          throw error(tokens.previous(), "A program in HULK can consist of just one global expression.");
+        }
+        const TT last = tokens.previous().get_type();
+        if (last != TT::SEMICOLON && last != TT::RBRACE) {
+          throw error(tokens.peek(), "Expected ';' after main expression.");
+        }
+        main_expr = expr;
+        break;
+      }
+
+      case action::TOKEN:
+        toks.push_back(tokens.previous());
+        break;
+
+      case action::EMPTY_TOKEN:
+        toks.emplace_back();
+        break;
+
+      case action::MISSING_TYPE:
+        error(tokens.peek(), "Expected type.");
+        toks.emplace_back();
+        break;
+
+      case action::MARK:
+        marks.push_back({toks.size(), exprs.size(), params.size(), fields.size(), functions.size()});
+        break;
+
+      // ======================== Declaraciones
+
+      case action::PARAM: {
+        lexer::token type = pop(toks);
+        lexer::token name = pop(toks);
+        params.emplace_back(name, type);
+        break;
+      }
+
+      case action::FUNCTION:
+        statements.push_back(function(ast::function_type::FUNCTION));
+        break;
+
+      case action::METHOD:
+        functions.push_back(function(ast::function_type::METHOD));
+        break;
+
+      case action::SIGNATURE: {
+        const mark m = pop(marks);
+        lexer::token return_type = pop(toks);
+        lexer::token name = pop(toks);
+        functions.push_back(nodes.make<ast::function_stmt>(
+            name, ast::function_type::METHOD, take(params, m.params), nullptr, return_type));
+        break;
+      }
+
+      case action::SUPER: {
+        const mark m = pop(marks);
+        std::vector<ast::expr_ptr> args = take(exprs, m.exprs);
+        lexer::token name = pop(toks);
+        supers.push_back(nodes.make<ast::super_item>(name, std::move(args)));
+        break;
+      }
+
+      case action::NO_SUPER:
+        supers.emplace_back();
+        break;
+
+      case action::FIELD: {
+        ast::expr_ptr init = pop(exprs);
+        lexer::token type = pop(toks);
+        lexer::token name = pop(toks);
+        fields.push_back(nodes.make<ast::field_stmt>(name, type, init));
+        break;
+      }
+
+      case action::CLASS: {
+        const mark m = pop(marks);
+        std::optional<ast::super_item_ptr> super_class = pop(supers);
+        std::vector<ast::function_stmt_ptr> methods = take(functions, m.functions);
+        std::vector<ast::field_stmt_ptr> class_fields = take(fields, m.fields);
+        std::vector<ast::parameter> parameters = take(params, m.params);
+        lexer::token name = pop(toks);
+        statements.push_back(nodes.make<ast::class_stmt>(
+            name, std::move(parameters), super_class, std::move(class_fields), std::move(methods)));
+        break;
+      }
+
+      case action::PROTOCOL: {
+        const mark m = pop(marks);
+        std::vector<ast::function_stmt_ptr> methods = take(functions, m.functions);
+        lexer::token super_protocol = pop(toks);
+        lexer::token name = pop(toks);
+        statements.push_back(nodes.make<ast::protocol_stmt>(name, std::move(methods), super_protocol));
+        break;
+      }
+
+      // ======================== Expresiones
+
+      case action::DECLARATION: {
+        ast::expr_ptr init = pop(exprs);
+        lexer::token type = pop(toks);
+        lexer::token name = pop(toks);
+        exprs.push_back(nodes.make<ast::declaration_expr>(name, type, init));
+        break;
+      }
+
+      case action::NULL_EXPR:
+        exprs.push_back(nodes.make<ast::literal_expr>(nullptr));
+        break;
+
+      case action::LET: {
+        ast::expr_ptr body = pop(exprs);
+        const mark m = pop(marks);
+        std::vector<ast::declaration_expr_ptr> declarations;
+        for (size_t i = m.exprs; i < exprs.size(); ++i)
+          declarations.push_back(static_cast<ast::declaration_expr_ptr>(exprs[i]));
+        exprs.erase(exprs.begin() + m.exprs, exprs.end());
+        exprs.push_back(nodes.make<ast::let_expr>(std::move(declarations), body));
+        break;
+      }
+
+      case action::NO_EXPR:
+        exprs.push_back(nullptr);
+        break;
+
+      case action::IF: {
+        ast::expr_ptr else_expr = pop(exprs);
+        const mark m = pop(marks);
+        std::vector<std::pair<ast::expr_ptr, ast::expr_ptr>> elif_branchs;
+        for (size_t i = m.exprs; i < exprs.size(); i += 2)
+          elif_branchs.emplace_back(exprs[i], exprs[i + 1]);
+        exprs.erase(exprs.begin() + m.exprs, exprs.end());
+        std::vector<lexer::token> elif_tokens = take(toks, m.toks);
+
+        std::optional<ast::expr_ptr> else_branch;
+        if (else_expr) else_branch = else_expr;
+        ast::expr_ptr then_branch = pop(exprs);
+        ast::expr_ptr condition = pop(exprs);
+        lexer::token condition_token = pop(toks);
+        exprs.push_back(nodes.make<ast::if_expr>(
+            condition_token, condition, then_branch, std::move(elif_tokens),
+            std::move(elif_branchs), else_branch));
+        break;
+      }
+
+      case action::WHILE: {
+        ast::expr_ptr body = pop(exprs);
+        ast::expr_ptr condition = pop(exprs);
+        lexer::token condition_token = pop(toks);
+        exprs.push_back(nodes.make<ast::while_expr>(condition_token, condition, body));
+        break;
+      }
+
+      case action::FOR: {
+        ast::expr_ptr body = pop(exprs);
+        ast::expr_ptr iterable = pop(exprs);
+        lexer::token type = pop(toks);
+        lexer::token name = pop(toks);
+        exprs.push_back(nodes.make<ast::for_expr>(name, type, iterable, body));
+        break;
+      }
+
+      case action::BLOCK: {
+        const mark m = pop(marks);
+        exprs.push_back(nodes.make<ast::block_expr>(take(exprs, m.exprs)));
+        break;
+      }
+
+      case action::ASSIGN: {
+        ast::expr_ptr value = pop(exprs);
+        lexer::token equals = pop(toks);
+        ast::expr_ptr target = pop(exprs);
+        if (dynamic_cast<ast::var_expr *>(target)) {
+          lexer::token type;
+          exprs.push_back(nodes.make<ast::assign_expr>(target, type, value));
+        } else {
+          error(equals, "Invalid assignment target.");
+          exprs.push_back(target);
+        }
+        break;
+      }
+
+      case action::BINARY: {
+        ast::expr_ptr right = pop(exprs);
+        lexer::token token = pop(toks);
+        ast::expr_ptr left = pop(exprs);
+        exprs.push_back(nodes.make<ast::binary_expr>(
+            left, token, static_cast<ast::binary_op>(token.get_type()), right));
+        break;
+      }
+
+      case action::UNARY: {
+        ast::expr_ptr right = pop(exprs);
+        lexer::token token = pop(toks);
+        exprs.push_back(nodes.make<ast::unary_expr>(
+            token, static_cast<ast::unary_op>(token.get_type()), right));
+        break;
+      }
+
+      case action::LITERAL: {
+        const lexer::token &token = tokens.previous();
+        switch (token.get_type()) {
+          case TT::FALSE:
+            exprs.push_back(nodes.make<ast::literal_expr>(false));
+            break;
+          case TT::TRUE:
+            exprs.push_back(nodes.make<ast::literal_expr>(true));
+            break;
+          case TT::T_NULL:
+            exprs.push_back(nodes.make<ast::literal_expr>(nullptr));
+            break;
+          default:  // NUMBER o STRING
+            exprs.push_back(nodes.make<ast::literal_expr>(token.get_literal()));
+        }
+        break;
+      }
+
+      case action::MEMBER_CALL: {
+        const mark m = pop(marks);
+        std::vector<ast::expr_ptr> arguments = take(exprs, m.exprs);
+        lexer::token name = pop(toks);
+        std::optional<ast::expr_ptr> object = pop(exprs);
+        exprs.push_back(nodes.make<ast::call_expr>(object, name, std::move(arguments)));
+        break;
+      }
+
+      case action::MEMBER_VAR: {
+        lexer::token name = pop(toks);
+        std::optional<ast::expr_ptr> object = pop(exprs);
+        exprs.push_back(nodes.make<ast::var_expr>(object, name));
+        break;
+      }
+
+      case action::CALL: {
+        const mark m = pop(marks);
+        std::vector<ast::expr_ptr> arguments = take(exprs, m.exprs);
+        lexer::token name = pop(toks);
+        exprs.push_back(nodes.make<ast::call_expr>(std::nullopt, name, std::move(arguments)));
+        break;
+      }
+
+      case action::VAR:
+        exprs.push_back(nodes.make<ast::var_expr>(std::nullopt, pop(toks)));
+        break;
+
+      case action::NEW: {
+        const mark m = pop(marks);
+        std::vector<ast::expr_ptr> arguments = take(exprs, m.exprs);
+        lexer::token name = pop(toks);
+        exprs.push_back(nodes.make<ast::new_expr>(name, std::move(arguments)));
+        break;
+      }
+    }
+  }
+
+  // funcion o metodo: el nombre esta antes de la marca, despues los
+  // parametros, el tipo de retorno y el cuerpo
+  ast::function_stmt_ptr function(const ast::function_type type) {
+    const mark m = pop(marks);
+    ast::expr_ptr body = pop(exprs);
+    lexer::token return_type = pop(toks);
+    std::vector<ast::parameter> parameters = take(params, m.params);
+    lexer::token name = pop(toks);
+    return nodes.make<ast::function_stmt>(name, type, std::move(parameters), body, return_type);
+  }
+
+  template <class T>
+  static T pop(std::vector<T> &stack) {
+    T value = std::move(stack.back());
+    stack.pop_back();
+    return value;
+  }
+
+  // saca los elementos desde from hasta el tope, en orden
+  template <class T>
+  static std::vector<T> take(std::vector<T> &stack, const size_t from) {
+    std::vector<T> result(std::make_move_iterator(stack.begin() + from),
+                          std::make_move_iterator(stack.end()));
+    stack.erase(stack.begin() + from, stack.end());
+    return result;
+  }
+
+  // mensaje para cuando no hay produccion: los tokens con los que si habia
+  static std::string expected(const uint16_t nonterminal) {
+    std::string message = std::string("Unexpected token in ") + ll1::nonterminal_names[nonterminal] + ", expected";
+    const char *separator = " ";
+    for (uint16_t t = 0; t < ll1::terminals; ++t) {
+      if (ll1::table[nonterminal * ll1::terminals + t] == ll1::no_production) continue;
+      message += separator + lexer::token_type_to_string(static_cast<TT>(t));
+      separator = ", ";
+    }
+    return message + ".";
+  }
+
+  static parse_error error(const lexer::token &token, const std::string &message) {
+    internal::error(token, message, "parser");
+    return parse_error(message);
+  }
+};
+
+}  // namespace parser
+
+}  // namespace hulk
+
+#endif  // HULK_LL1_PARSER_HPP
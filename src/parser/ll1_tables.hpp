@@ -0,0 +1,214 @@
+// Generado por ll1_generator.cpp a partir de grammar_LL1.txt, no editar.
+#ifndef HULK_LL1_TABLES_HPP
+#define HULK_LL1_TABLES_HPP 1
+
+#include <cstdint>
+
+namespace hulk {
+
+namespace parser {
+
+namespace ll1 {
+
+// 81 terminales, 55 no terminales, 115 producciones
+constexpr uint16_t terminals = 81;
+constexpr uint16_t nonterminals = 55;
+constexpr uint16_t first_action = 136;
+constexpr uint16_t start = 81;  // program
+constexpr uint8_t no_production = 255;
+
+enum class action : uint16_t {
+  MAIN,
+  TOKEN,
+  MARK,
+  FUNCTION,
+  PARAM,
+  EMPTY_TOKEN,
+  CLASS,
+  SUPER,
+  NO_SUPER,
+  METHOD,
+  FIELD,
+  PROTOCOL,
+  SIGNATURE,
+  MISSING_TYPE,
+  LET,
+  DECLARATION,
+  NULL_EXPR,
+  IF,
+  NO_EXPR,
+  WHILE,
+  FOR,
+  BLOCK,
+  ASSIGN,
+  BINARY,
+  UNARY,
+  MEMBER_CALL,
+  MEMBER_VAR,
+  LITERAL,
+  NEW,
+  CALL,
+  VAR,
+};
+
+constexpr const char *nonterminal_names[55] = {
+    "program",
+    "items",
+    "item",
+    "opt_semicolon",
+    "function",
+    "fn_rest",
+    "fn_body",
+    "params",
+    "more_params",
+    "opt_type",
+    "type_decl",
+    "type_params",
+    "inherits",
+    "super_args",
+    "members",
+    "member",
+    "protocol_decl",
+    "extends",
+    "signatures",
+    "typed_params",
+    "more_typed_params",
+    "typed_type",
+    "expr",
+    "let_rest",
+    "declarations",
+    "declaration",
+    "initializer",
+    "if_rest",
+    "elifs",
+    "else_branch",
+    "while_rest",
+    "for_rest",
+    "block_body",
+    "block_items",
+    "assignment",
+    "assign_tail",
+    "or_expr",
+    "or_tail",
+    "and_expr",
+    "and_tail",
+    "equality",
+    "equality_tail",
+    "comparison",
+    "comparison_tail",
+    "term",
+    "term_tail",
+    "factor",
+    "factor_tail",
+    "unary",
+    "postfix",
+    "member_access",
+    "primary",
+    "identifier_rest",
+    "arguments",
+    "more_arguments",
+};
+
+// lado derecho de la produccion p: rhs[rhs_start[p], rhs_start[p + 1])
+constexpr uint16_t rhs_start[116] = {
+    0,2,4,4,7,10,13,16,17,17,22,27,30,32,37,37,
+    43,43,46,47,56,59,59,65,66,70,70,74,74,77,81,89,
+    92,93,103,103,108,108,114,114,117,118,120,122,124,126,128,129,
+    135,138,138,143,145,146,155,162,162,164,165,171,180,184,187,187,
+    189,193,193,195,200,200,202,207,207,209,214,219,219,221,226,231,
+    236,241,241,243,248,253,253,255,260,265,270,275,280,285,285,289,
+    293,295,300,300,305,306,308,310,312,314,316,319,322,330,335,336,
+    338,338,341,341,
+};
+
+constexpr uint16_t rhs[341] = {
+    82,79,83,82,17,85,84,20,91,84,25,97,84,103,84,136,
+    55,0,137,138,86,139,59,88,60,90,87,74,103,55,61,113,
+    0,137,90,140,89,57,0,137,90,140,89,56,0,137,141,0,
+    137,138,92,93,61,95,62,142,59,88,60,22,0,137,138,94,
+    143,144,59,103,135,60,0,137,96,95,138,86,145,90,107,55,
+    146,0,137,98,61,138,99,62,147,26,0,137,141,0,137,59,
+    138,100,60,102,148,55,99,0,137,102,140,101,57,0,137,102,
+    140,101,56,0,137,149,18,104,12,108,15,111,61,113,16,112,
+    115,138,106,105,19,103,150,57,106,105,0,137,90,107,151,37,
+    103,152,59,137,103,60,103,138,109,110,153,13,59,137,103,60,
+    103,109,14,103,154,59,137,103,60,103,155,59,0,137,90,19,
+    103,60,103,156,138,114,62,157,103,55,114,117,116,38,137,115,
+    158,119,118,53,137,119,159,118,121,120,52,137,121,159,120,123,
+    122,45,137,123,159,122,44,137,123,159,122,125,124,48,137,125,
+    159,124,49,137,125,159,124,46,137,125,159,124,47,137,125,159,
+    124,127,126,28,137,127,159,126,27,137,127,159,126,129,128,30,
+    137,129,159,128,31,137,129,159,128,29,137,129,159,128,34,137,
+    129,159,128,35,137,129,159,128,36,137,129,159,128,54,137,129,
+    160,28,137,129,160,132,130,58,0,137,131,130,59,138,134,60,
+    161,162,5,163,4,163,11,163,1,163,2,163,0,137,133,59,
+    103,60,21,0,137,59,138,134,60,164,59,138,134,60,165,166,
+    103,135,57,103,135,
+};
+
+// produccion para (no terminal, token) o no_production
+constexpr uint8_t table[55 * 81] = {
+    0,0,0,255,0,0,255,255,255,255,255,0,0,255,255,0,0,0,0,255,0,0,255,255,255,0,255,255,0,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,0,255,255,255,255,0,255,0,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,0,255,
+    1,1,1,255,1,1,255,255,255,255,255,1,1,255,255,1,1,1,1,255,1,1,255,255,255,1,255,255,1,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,1,255,255,255,255,1,255,1,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,2,255,
+    6,6,6,255,6,6,255,255,255,255,255,6,6,255,255,6,6,3,6,255,4,6,255,255,255,5,255,255,6,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,6,255,255,255,255,6,255,6,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    8,8,8,255,8,8,255,255,255,255,255,8,8,255,255,8,8,8,8,255,8,8,255,255,255,8,255,255,8,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,8,7,255,255,255,8,255,8,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,8,255,
+    9,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,10,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,12,255,255,255,255,255,255,255,255,255,255,255,255,11,255,255,255,255,255,255,
+    13,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,14,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,15,255,255,16,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,18,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,18,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,18,17,18,255,255,18,18,255,255,255,255,255,255,255,255,255,255,255,255,18,255,255,255,255,255,255,
+    19,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,21,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,20,255,21,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,22,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,23,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,24,255,25,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    26,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,27,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,29,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,29,29,255,255,28,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    30,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,31,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,32,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    33,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,34,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    35,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,36,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,37,255,255,38,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,40,39,40,255,255,40,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    46,46,46,255,46,46,255,255,255,255,255,46,42,255,255,43,45,255,41,255,255,46,255,255,255,255,255,255,46,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,46,255,255,255,255,46,255,44,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    47,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,49,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,48,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    50,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,52,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,51,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,52,255,52,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,53,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    55,55,55,255,55,55,255,255,255,255,255,55,55,54,55,55,55,55,55,55,55,55,255,255,255,55,255,255,55,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,55,55,255,55,255,55,55,55,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,55,255,
+    57,57,57,255,57,57,255,255,255,255,255,57,57,57,56,57,57,57,57,57,57,57,255,255,255,57,255,255,57,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,57,57,255,57,255,57,57,57,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,57,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,58,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,59,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    60,60,60,255,60,60,255,255,255,255,255,60,60,255,255,60,60,255,60,255,255,60,255,255,255,255,255,255,60,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,60,255,255,255,255,60,255,60,60,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    61,61,61,255,61,61,255,255,255,255,255,61,61,255,255,61,61,255,61,255,255,61,255,255,255,255,255,255,61,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,61,255,255,255,255,61,255,61,62,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    63,63,63,255,63,63,255,255,255,255,255,63,255,255,255,255,255,255,255,255,255,63,255,255,255,255,255,255,63,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,63,255,255,255,255,63,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    65,65,65,255,65,65,255,255,255,255,255,65,65,65,65,65,65,65,65,65,65,65,255,255,255,65,255,255,65,255,255,255,255,255,255,255,255,255,64,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,65,65,255,65,255,65,65,65,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,65,255,
+    66,66,66,255,66,66,255,255,255,255,255,66,255,255,255,255,255,255,255,255,255,66,255,255,255,255,255,255,66,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,66,255,255,255,255,66,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    68,68,68,255,68,68,255,255,255,255,255,68,68,68,68,68,68,68,68,68,68,68,255,255,255,68,255,255,68,255,255,255,255,255,255,255,255,255,68,255,255,255,255,255,255,255,255,255,255,255,255,255,255,67,68,68,255,68,255,68,68,68,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,68,255,
+    69,69,69,255,69,69,255,255,255,255,255,69,255,255,255,255,255,255,255,255,255,69,255,255,255,255,255,255,69,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,69,255,255,255,255,69,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    71,71,71,255,71,71,255,255,255,255,255,71,71,71,71,71,71,71,71,71,71,71,255,255,255,71,255,255,71,255,255,255,255,255,255,255,255,255,71,255,255,255,255,255,255,255,255,255,255,255,255,255,70,71,71,71,255,71,255,71,71,71,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,71,255,
+    72,72,72,255,72,72,255,255,255,255,255,72,255,255,255,255,255,255,255,255,255,72,255,255,255,255,255,255,72,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,72,255,255,255,255,72,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    75,75,75,255,75,75,255,255,255,255,255,75,75,75,75,75,75,75,75,75,75,75,255,255,255,75,255,255,75,255,255,255,255,255,255,255,255,255,75,255,255,255,255,255,74,73,255,255,255,255,255,255,75,75,75,75,255,75,255,75,75,75,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,75,255,
+    76,76,76,255,76,76,255,255,255,255,255,76,255,255,255,255,255,255,255,255,255,76,255,255,255,255,255,255,76,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,76,255,255,255,255,76,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    81,81,81,255,81,81,255,255,255,255,255,81,81,81,81,81,81,81,81,81,81,81,255,255,255,81,255,255,81,255,255,255,255,255,255,255,255,255,81,255,255,255,255,255,81,81,79,80,77,78,255,255,81,81,81,81,255,81,255,81,81,81,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,81,255,
+    82,82,82,255,82,82,255,255,255,255,255,82,255,255,255,255,255,255,255,255,255,82,255,255,255,255,255,255,82,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,82,255,255,255,255,82,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    85,85,85,255,85,85,255,255,255,255,255,85,85,85,85,85,85,85,85,85,85,85,255,255,255,85,255,84,83,255,255,255,255,255,255,255,255,255,85,255,255,255,255,255,85,85,85,85,85,85,255,255,85,85,85,85,255,85,255,85,85,85,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,85,255,
+    86,86,86,255,86,86,255,255,255,255,255,86,255,255,255,255,255,255,255,255,255,86,255,255,255,255,255,255,86,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,86,255,255,255,255,86,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    93,93,93,255,93,93,255,255,255,255,255,93,93,93,93,93,93,93,93,93,93,93,255,255,255,93,255,93,93,89,87,88,255,255,90,91,92,255,93,255,255,255,255,255,93,93,93,93,93,93,255,255,93,93,93,93,255,93,255,93,93,93,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,93,255,
+    96,96,96,255,96,96,255,255,255,255,255,96,255,255,255,255,255,255,255,255,255,96,255,255,255,255,255,255,95,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,94,255,255,255,255,96,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    98,98,98,255,98,98,255,255,255,255,255,98,98,98,98,98,98,98,98,98,98,98,255,255,255,98,255,98,98,98,98,98,255,255,98,98,98,255,98,255,255,255,255,255,98,98,98,98,98,98,255,255,98,98,98,98,255,98,97,98,98,98,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,98,255,
+    100,100,100,255,100,100,255,255,255,255,255,100,100,100,100,100,100,100,100,100,100,100,255,255,255,100,255,100,100,100,100,100,255,255,100,100,100,255,100,255,255,255,255,255,100,100,100,100,100,100,255,255,100,100,100,100,255,100,100,99,100,100,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,100,255,
+    106,104,105,255,102,101,255,255,255,255,255,103,255,255,255,255,255,255,255,255,255,108,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,107,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    110,110,110,255,110,110,255,255,255,255,255,110,110,110,110,110,110,110,110,110,110,110,255,255,255,110,255,110,110,110,110,110,255,255,110,110,110,255,110,255,255,255,255,255,110,110,110,110,110,110,255,255,110,110,110,110,255,110,110,109,110,110,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,110,255,
+    111,111,111,255,111,111,255,255,255,255,255,111,111,255,255,111,111,255,111,255,255,111,255,255,255,255,255,255,111,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,111,255,255,255,255,111,112,111,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,113,255,255,114,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+};
+
+}  // namespace ll1
+
+}  // namespace parser
+
+}  // namespace hulk
+
+#endif  // HULK_LL1_TABLES_HPP
@@ -0,0 +1,183 @@
+#ifndef HULK_PARSER_PARALLEL_HPP
+#define HULK_PARSER_PARALLEL_HPP 1
+
+#include <algorithm>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../ast/ast"
+#include "../internal/internal_error"
+#include "../lexer/token_array"
+#include "../lexer/token_stream"
+#include "../lexer/tokens"
+#include "parser"
+
+namespace hulk {
+
+namespace parser {
+
+// Declaraciones de primer nivel (function, type, protocol) de tokens, con el
+// ';' opcional que las sigue. Solo cuenta llaves y parentesis: una funcion
+// inline termina en el primer ';' fuera de ellos y el resto en la llave que
+// cierra su cuerpo. Si algo no cierra devuelve lo que encontro hasta ahi;
+// el parser igual verifica que cada rango sea exactamente una declaracion.
+std::vector<token_range> find_declarations(const lexer::token_array &tokens) {
+  using TT = lexer::token_type;
+  std::vector<token_range> result;
+  const size_t end = tokens.size() - 1;  // el ultimo es END_OF_FILE
+  int depth = 0;
+
+  for (size_t i = 0; i < end; ++i) {
+    const TT type = tokens.type(i);
+    if (type == TT::LBRACE || type == TT::LPAREN) ++depth;
+    if (type == TT::RBRACE || type == TT::RPAREN) --depth;
+    if (depth != 0 || (type != TT::KW_FUNCTION && type != TT::KW_TYPE &&
+                       type != TT::KW_PROTOCOL))
+      continue;
+
+    // hasta el cuerpo: '=>' (solo funciones) o '{', fuera de parentesis
+    size_t j = i + 1;
+    int parens = 0;
+    for (; j < end; ++j) {
+      const TT t = tokens.type(j);
+      if (t == TT::LPAREN) ++parens;
+      if (t == TT::RPAREN) --parens;
+      if (parens == 0 && (t == TT::LBRACE || t == TT::ARROW)) break;
+      if (t == TT::KW_FUNCTION || t == TT::KW_TYPE || t == TT::KW_PROTOCOL)
+        return result;
+    }
+    if (j == end) return result;
+
+    // el cuerpo termina en '}' o, si es inline, en ';'
+    const TT closer = tokens.type(j) == TT::ARROW ? TT::SEMICOLON : TT::RBRACE;
+    int inner = tokens.type(j) == TT::LBRACE ? 1 : 0;
+    for (++j; j < end; ++j) {
+      const TT t = tokens.type(j);
+      if (t == TT::LBRACE || t == TT::LPAREN) ++inner;
+      if (t == TT::RBRACE || t == TT::RPAREN) --inner;
+      if (t == closer && inner == 0) break;
+    }
+    if (j == end) return result;
+
+    ++j;
+    if (tokens.type(j) == TT::SEMICOLON) ++j;
+    result.emplace_back(i, j);
+    i = j - 1;
+  }
+  return result;
+}
+
+// Igual que parser(tokens).parse() pero las declaraciones de primer nivel se
+// reparten entre workers hilos, cada uno con su arena. El hilo principal
+// parsea el resto (la expresion global) salteandolas y despues se cosen los
+// resultados en orden; las arenas de los hilos pasan a la del programa.
+// Los hilos no imprimen errores: si alguno encuentra uno (o un rango no era
+// una declaracion) se descarta todo y se parsea de nuevo de corrido, asi los
+// errores salen igual que con el parser secuencial.
+ast::program parse_parallel(const lexer::token_array &tokens,
+                            unsigned workers = std::thread::hardware_concurrency()) {
+  const std::vector<token_range> declarations = find_declarations(tokens);
+
+  auto sequential = [&tokens]() {
+    lexer::token_stream stream(tokens);
+    return parser(stream).parse();
+  };
+  if (workers < 2 || declarations.size() < 2) return sequential();
+  workers = std::min<size_t>(workers, declarations.size());
+
+  // cada hilo toma declaraciones seguidas con mas o menos los mismos tokens
+  size_t total = 0;
+  for (const auto &[first, second] : declarations) total += second - first;
+  std::vector<size_t> batch_start = {0};
+  for (size_t i = 0, acc = 0; i < declarations.size(); ++i) {
+    acc += declarations[i].second - declarations[i].first;
+    if (batch_start.size() < workers && acc * workers >= total * batch_start.size())
+      batch_start.push_back(i + 1);
+  }
+  batch_start.push_back(declarations.size());
+  batch_start.erase(std::unique(batch_start.begin(), batch_start.end()), batch_start.end());
+
+  struct batch {
+    ast::ast_arena nodes;
+    std::vector<ast::stmt_ptr> statements;
+    bool failed = false;
+  };
+  std::vector<batch> batches(batch_start.size() - 1);
+
+  // las declaraciones seguidas del lote se parsean con un solo parser (la
+  // expresion global puede partir un lote en dos tramos)
+  auto run_batch = [&](size_t b) {
+    batch &out = batches[b];
+    internal::silenced_errors = &out.failed;
+    try {
+      for (size_t i = batch_start[b]; i < batch_start[b + 1] && !out.failed;) {
+        size_t j = i + 1;
+        while (j < batch_start[b + 1] && declarations[j].first == declarations[j - 1].second) ++j;
+
+        lexer::token_stream stream(tokens, declarations[i].first, declarations[j - 1].second);
+        ast::program piece = parser(stream).parse();
+        if (piece.statements.size() != j - i || piece.main) out.failed = true;
+        out.statements.insert(out.statements.end(), piece.statements.begin(), piece.statements.end());
+        out.nodes.absorb(std::move(piece.arena));
+        i = j;
+      }
+    } catch (...) {
+      out.failed = true;
+    }
+    internal::silenced_errors = nullptr;
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t b = 0; b < batches.size(); ++b) threads.emplace_back(run_batch, b);
+
+  // mientras tanto la expresion global
+  bool failed = false;
+  internal::silenced_errors = &failed;
+  lexer::token_stream stream(tokens);
+  ast::program program = parser(stream, declarations).parse();
+  internal::silenced_errors = nullptr;
+
+  for (auto &thread : threads) thread.join();
+
+  std::vector<ast::stmt_ptr> parsed;
+  for (auto &b : batches) {
+    failed = failed || b.failed;
+    parsed.insert(parsed.end(), b.statements.begin(), b.statements.end());
+  }
+  if (failed || parsed.size() != declarations.size() ||
+      std::count(program.statements.begin(), program.statements.end(), nullptr) !=
+          static_cast<std::ptrdiff_t>(declarations.size()))
+    return sequential();
+
+  auto next = parsed.begin();
+  for (auto &statement : program.statements)
+    if (!statement) statement = *next++;
+  for (auto &b : batches) program.arena.absorb(std::move(b.nodes));
+  return ast::program(std::move(program.arena), std::move(program.statements), program.main);
+}
+
+// Lo mismo desde el texto. lex_compact encuentra los errores lexicos antes
+// de que el parser empiece, asi que saldrian todos antes que los de sintaxis;
+// se anotan sin imprimir y, si hubo alguno, se parsea de corrido con el
+// lexer a pedido para que salgan en el orden del archivo, como sin hilos.
+ast::program parse_parallel(std::string_view source,
+                            unsigned workers = std::thread::hardware_concurrency()) {
+  bool lexical_errors = false;
+  internal::silenced_errors = &lexical_errors;
+  const lexer::token_array tokens = lexer::lex_compact(source);
+  internal::silenced_errors = nullptr;
+
+  if (lexical_errors) {
+    lexer::token_stream stream(source);
+    return parser(stream).parse();
+  }
+  return parse_parallel(tokens, workers);
+}
+
+}  // namespace parser
+
+}  // namespace hulk
+
+#endif  // HULK_PARSER_PARALLEL_HPP
@@ -1,16 +1,20 @@
 #ifndef HULK_PARSER_H
 #define HULK_PARSER_H 1
 
+#include <array>
 #include <cassert>
-#include <functional>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "../ast/ast"
 #include "../ast/enums"
 #include "../internal/internal_error"
+#include "../internal/internal_stack"
+#include "../lexer/token_stream"
 #include "../lexer/tokens"
 
 namespace hulk {
@@ -21,15 +25,75 @@ struct parse_error final : public std::runtime_error {
   explicit parse_error(const std::string &message) : runtime_error(message) {}
 };
 
+// Se llego a internal::max_errors: no se sigue parseando
+struct parse_aborted final : public std::runtime_error {
+  parse_aborted() : runtime_error("too many errors") {}
+};
+
+// Precedencia de cada operador binario (0 si el token no es uno); todos
+// asocian a la izquierda:
+//   | < & < == != < < > <= >= < + - < * / % ^ @ @@
+constexpr std::array<uint8_t, lexer::UNKNOWN + 1> binary_precedences() {
+  using TT = lexer::token_type;
+  std::array<uint8_t, lexer::UNKNOWN + 1> table{};
+  table[TT::OP_OR] = 1;
+  table[TT::OP_AND] = 2;
+  for (auto type : {TT::OP_NOT_EQUAL, TT::OP_EQUAL}) table[type] = 3;
+  for (auto type :
+       {TT::OP_GREATER, TT::OP_GREATER_EQ, TT::OP_LESS, TT::OP_LESS_EQ})
+    table[type] = 4;
+  for (auto type : {TT::OP_MINUS, TT::OP_PLUS}) table[type] = 5;
+  for (auto type : {TT::OP_DIVIDE, TT::OP_MODULE, TT::OP_MULTIPLY,
+                    TT::OP_EXPONENT, TT::OP_CONCAT, TT::OP_DOBLE_CONCAT})
+    table[type] = 6;
+  return table;
+}
+
+constexpr std::array<uint8_t, lexer::UNKNOWN + 1> binary_precedence =
+    binary_precedences();
+
+// Tokens [first, second) de un token_array
+using token_range = std::pair<size_t, size_t>;
+
+/*  Recuperacion de errores
+    Un error no corta el parseo, asi una sola pasada (lineal en los tokens)
+    muestra todos los errores de sintaxis:
+      - a nivel de frase: si falta un cierre (';', ')', '}', 'in') y lo que
+        sigue es otro cierre, el fin del archivo o esta en otra linea, se
+        reporta y se sigue como si estuviera (expect),
+      - panic mode: si no, se descartan tokens hasta un punto seguro: el
+        siguiente elemento del bloque o del cuerpo del type/protocol
+        (sync_item), el final de la function/type/protocol con el error
+        (sync_declaration) o la siguiente declaracion (sync),
+      - un error sin haber consumido nada desde el anterior es consecuencia
+        de ese y no se muestra, tampoco uno en un token UNKNOWN (ya lo
+        reporto el lexer),
+      - despues de internal::max_errors se deja de parsear (parse_aborted).
+    Cada recuperacion consume al menos un token o termina un ciclo, asi que
+    no hay forma de quedar dando vueltas en el mismo lugar.
+*/
 struct parser {
-  explicit parser(const std::vector<lexer::token> &_tokens) : tokens(_tokens) {}
+  explicit parser(lexer::token_stream &_tokens) : tokens(_tokens) {}
+
+  // Las declaraciones en skipped (en orden) no se parsean: se saltean y en
+  // su lugar queda un nullptr en program.statements (ver parse_parallel)
+  parser(lexer::token_stream &_tokens, const std::vector<token_range> &_skipped)
+      : tokens(_tokens), skipped(&_skipped) {}
 
   ast::program parse() {
     std::vector<ast::stmt_ptr> decl_list;
-    ast::expr_ptr main_expr;
+    ast::expr_ptr main_expr = nullptr;
     try {
       bool found_expr = false;
       while (!is_at_end()) {
+        const size_t start = tokens.position();
+        if (skipped && next_skipped < skipped->size() &&
+            tokens.position() == (*skipped)[next_skipped].first) {
+          tokens.seek((*skipped)[next_skipped++].second);
+          decl_list.push_back(nullptr);
+          continue;
+        }
+
         if (auto decl = declaration(); decl.has_value()) {
           decl_list.push_back(std::move(decl.value()));
         }
@@ -39,39 +103,49 @@ struct parser {
       
         if (!decl_list.empty()) {
           auto stmt = decl_list.back();
-          if (ast::expression_stmt *t = dynamic_cast<ast::expression_stmt *>(stmt.get())) {
+          if (ast::expression_stmt *t = dynamic_cast<ast::expression_stmt *>(stmt)) {
             if (found_expr) {
               error(previous(), "A program in HULK can consist of just one global expression.");
-              break;
+              decl_list.pop_back();
+              continue;
             }
 
-            if (!found_semicolon && previous().get_type() != TT::RBRACE) {
+            if (!found_semicolon && previous().get_type() != TT::RBRACE)
               error(peek(), "Expected ';' after main expression.");
-              break;
-            }
-            
+
             main_expr = std::move(t->expression);
             decl_list.pop_back();
             found_expr = true;
           }
         }
+
+        // el error estaba en el primer token y sync no lo consumio
+        if (tokens.position() == start) advance();
       }
     } catch (const std::invalid_argument &e) {
       std::cout << "error: " << e.what() << std::endl;
+    } catch (const parse_aborted &) {
     }
-    return ast::program(std::move(decl_list), std::move(main_expr));
+    return ast::program(std::move(nodes), std::move(decl_list), main_expr);
   }
 
  private:
-  std::vector<lexer::token> tokens;
+  // los tokens se piden al lexer a medida que se consumen
+  lexer::token_stream &tokens;
 
-  int current = 0;
+  // todos los nodos se crean aca y parse() se lo pasa al ast::program
+  ast::ast_arena nodes;
 
-  using TT = lexer::token_type;
+  const std::vector<token_range> *skipped = nullptr;
+  size_t next_skipped = 0;
 
-  using parserFn = ast::expr_ptr (parser::*)();
+  // posicion del token del ultimo error reportado
+  size_t last_error = SIZE_MAX;
+
+  using TT = lexer::token_type;
 
   std::optional<ast::stmt_ptr> declaration() {
+    const TT kind = peek().get_type();
     try {
       if (match(TT::KW_FUNCTION)) return function(ast::function_type::FUNCTION);
       if (match(TT::KW_TYPE)) return class_declaration();
@@ -79,7 +153,10 @@ struct parser {
 
       return statement();
     } catch (parse_error &) {
-      sync();
+      if (is_declaration(kind))
+        sync_declaration(kind);
+      else
+        sync();
       return std::make_optional<ast::stmt_ptr>();
     }
   }
@@ -105,34 +182,45 @@ struct parser {
 
     consume(TT::LBRACE, "Expected '{' before protocol signatures.");
 
+    std::vector<ast::function_stmt_ptr> methods = protocol_body();
+    return nodes.make<ast::protocol_stmt>(name, std::move(methods),
+                                                super_protocol);
+  }
+
+  // Firmas de un protocol hasta la '}' que cierra el cuerpo (la '{' ya se
+  // consumio)
+  std::vector<ast::function_stmt_ptr> protocol_body() {
     std::vector<ast::function_stmt_ptr> methods;
     while (!check(TT::RBRACE) && !is_at_end()) {
-      auto name = consume(TT::IDENTIFIER, "Expected method name.");
-
-      consume(TT::LPAREN, "Expected '(' before parameters.");
-
-      std::vector<ast::parameter> parameters;
-      if (!check(TT::RPAREN)) {
-        do {
-          auto param_name = consume(TT::IDENTIFIER, "Expected parameter name.");
-          auto param_type = opt_type(false);
-          parameters.push_back(ast::parameter(param_name, param_type));
-        } while (match(TT::COMMA));
-      }
+      try {
+        auto name = consume(TT::IDENTIFIER, "Expected method name.");
+
+        consume(TT::LPAREN, "Expected '(' before parameters.");
+
+        std::vector<ast::parameter> parameters;
+        if (!check(TT::RPAREN)) {
+          do {
+            auto param_name = consume(TT::IDENTIFIER, "Expected parameter name.");
+            auto param_type = opt_type(false);
+            parameters.push_back(ast::parameter(param_name, param_type));
+          } while (match(TT::COMMA));
+        }
 
-      consume(TT::RPAREN, "Expected ')' after parameters.");
+        expect(TT::RPAREN, "Expected ')' after parameters.");
 
-      auto return_type = opt_type(false);
-      methods.push_back(std::make_shared<ast::function_stmt>(
-          name, ast::function_type::METHOD, std::move(parameters), nullptr,
-          return_type));
+        auto return_type = opt_type(false);
+        methods.push_back(nodes.make<ast::function_stmt>(
+            name, ast::function_type::METHOD, std::move(parameters), nullptr,
+            return_type));
 
-      consume(TT::SEMICOLON, "Expected ';' after protocol method declaration.");
+        expect(TT::SEMICOLON, "Expected ';' after protocol method declaration.");
+      } catch (parse_error &) {
+        if (!sync_item(true)) throw;
+      }
     }
 
-    consume(TT::RBRACE, "Expected '}' after protocol signatures.");
-    return std::make_shared<ast::protocol_stmt>(name, std::move(methods),
-                                                super_protocol);
+    expect(TT::RBRACE, "Expected '}' after protocol signatures.");
+    return methods;
   }
 
   ast::class_stmt_ptr class_declaration() {
@@ -149,7 +237,7 @@ struct parser {
         } while (match(TT::COMMA));
       }
 
-      consume(TT::RPAREN, "Expected ')' after parameters");
+      expect(TT::RPAREN, "Expected ')' after parameters");
     }
 
     std::optional<ast::super_item_ptr> super_class;
@@ -164,47 +252,58 @@ struct parser {
           args.push_back(std::move(expr));
         } while (match(TT::COMMA));
 
-        consume(TT::RPAREN, "Expected ')' after superclass arguments.");
+        expect(TT::RPAREN, "Expected ')' after superclass arguments.");
       }
 
       super_class =
-          std::make_unique<ast::super_item>(super_name, std::move(args));
+          nodes.make<ast::super_item>(super_name, std::move(args));
     }
 
     consume(TT::LBRACE, "Expected '{' before type body.");
 
     std::vector<ast::field_stmt_ptr> fields;
     std::vector<ast::function_stmt_ptr> methods;
+    class_body(fields, methods);
+
+    return nodes.make<ast::class_stmt>(name, parameters, std::move(super_class), std::move(fields), std::move(methods));
+  }
+
+  // Campos y metodos de un type hasta la '}' que cierra el cuerpo (la '{'
+  // ya se consumio)
+  void class_body(std::vector<ast::field_stmt_ptr> &fields,
+                  std::vector<ast::function_stmt_ptr> &methods) {
     while (!check(TT::RBRACE) && !is_at_end()) {
-      auto name = consume(TT::IDENTIFIER, "Expected field or method name.");
+      try {
+        auto name = consume(TT::IDENTIFIER, "Expected field or method name.");
 
-      if (check(TT::LPAREN)) {
-        methods.push_back(function(ast::function_type::METHOD));
-      } else {
-        fields.push_back(field_declaration(name));
+        if (check(TT::LPAREN)) {
+          methods.push_back(function(ast::function_type::METHOD));
+        } else {
+          fields.push_back(field_declaration(name));
+        }
+      } catch (parse_error &) {
+        if (!sync_item(true)) throw;
       }
     }
 
-    consume(TT::RBRACE, "Expected '}' after type body.");
-
-    return std::make_shared<ast::class_stmt>(name, parameters, std::move(super_class), std::move(fields), std::move(methods));
+    expect(TT::RBRACE, "Expected '}' after type body.");
   }
 
   ast::field_stmt_ptr field_declaration(const lexer::token name) {
     lexer::token type = opt_type();
     ast::expr_ptr init = match(TT::OP_ASSIGN)
                              ? expression()
-                             : std::make_unique<ast::literal_expr>(nullptr);
-    consume(TT::SEMICOLON, "Expected ';' after field declaration.");
-    return std::make_shared<ast::field_stmt>(name, type, std::move(init));
+                             : nodes.make<ast::literal_expr>(nullptr);
+    expect(TT::SEMICOLON, "Expected ';' after field declaration.");
+    return nodes.make<ast::field_stmt>(name, type, std::move(init));
   }
 
   ast::while_expr_ptr while_expression() {
     auto condition_token = consume(TT::LPAREN, "Expected '(' after while.");
     ast::expr_ptr condition = expression();
-    consume(TT::RPAREN, "Expected ')' after condition.");
+    expect(TT::RPAREN, "Expected ')' after condition.");
     ast::expr_ptr body = expression();
-    return std::make_unique<ast::while_expr>(condition_token, std::move(condition),std::move(body));
+    return nodes.make<ast::while_expr>(condition_token, std::move(condition),std::move(body));
   }
 
   ast::stmt_ptr statement() { return expression_statement(); }
@@ -212,7 +311,7 @@ struct parser {
   ast::if_expr_ptr if_expression() {
     auto condition_token = consume(TT::LPAREN, "Expected '(' after 'if'.");
     auto condition = expression();
-    consume(TT::RPAREN, "Expected ')' after if condition.");
+    expect(TT::RPAREN, "Expected ')' after if condition.");
 
     auto then_branch = expression();
 
@@ -221,7 +320,7 @@ struct parser {
     while (match(TT::KW_ELIF)) {
       elif_tokens.push_back(consume(TT::LPAREN, "Expected '(' after 'elif'."));
       auto condition = expression();
-      consume(TT::RPAREN, "Expected ')' after elif condition");
+      expect(TT::RPAREN, "Expected ')' after elif condition");
 
       ast::expr_ptr cur_then_branch = expression();
       elif_branchs.emplace_back(std::move(condition),
@@ -233,7 +332,7 @@ struct parser {
       else_branch = expression();
     }
 
-    return std::make_unique<ast::if_expr>( 
+    return nodes.make<ast::if_expr>( 
         condition_token, std::move(condition), std::move(then_branch),
         std::move(elif_tokens), std::move(elif_branchs), 
         std::move(else_branch)
@@ -242,7 +341,7 @@ struct parser {
 
   ast::expression_stmt_ptr expression_statement() {
     ast::expr_ptr expr = expression();
-    return std::make_shared<ast::expression_stmt>(std::move(expr));
+    return nodes.make<ast::expression_stmt>(std::move(expr));
   }
 
   ast::function_stmt_ptr function(const ast::function_type type) {
@@ -267,49 +366,46 @@ struct parser {
       } while (match(TT::COMMA) && !is_at_end());
     }
 
-    consume(TT::RPAREN, "Expected ')' after parameters.");
+    expect(TT::RPAREN, "Expected ')' after parameters.");
 
     lexer::token return_type = opt_type();
 
     bool is_inline_fun = match(TT::ARROW);
 
-    ast::expr_ptr body;
+    ast::expr_ptr body = nullptr;
     if (is_inline_fun) {
       body = expression();
-      consume(TT::SEMICOLON, "Expected ';' after inline " + kind + " body.");
+      expect(TT::SEMICOLON, "Expected ';' after inline " + kind + " body.");
     } else {
       consume(TT::LBRACE, "Expected '{' before full-form " + kind + "body.");
       body = block_expression();
     }
 
-    return std::make_shared<ast::function_stmt>(name, type, parameters,
+    return nodes.make<ast::function_stmt>(name, type, parameters,
                                                 std::move(body), return_type);
   }
 
   ast::block_expr_ptr block_expression() {
     std::vector<ast::expr_ptr> expressions;
     while (!check(TT::RBRACE) && !is_at_end()) {
-      auto expr = expression();
-      expressions.push_back(std::move(expr));
-      consume(TT::SEMICOLON, "Expected ';' after expressions in block.");
-    }
-    consume(TT::RBRACE, "Expected '}' after block.");
-    return std::make_unique<ast::block_expr>(std::move(expressions));
-  }
-
-  ast::expr_ptr parse_binary_expr(
-      const std::initializer_list<lexer::token_type> &types, ast::expr_ptr expr,
-      const parserFn &f) {
-    while (match(types)) {
-      auto token = previous();
-      expr = std::make_unique<ast::binary_expr>(
-          std::move(expr), token, static_cast<ast::binary_op>(token.get_type()),
-          std::invoke(f, this));
+      try {
+        auto expr = expression();
+        expressions.push_back(std::move(expr));
+        expect(TT::SEMICOLON, "Expected ';' after expressions in block.");
+      } catch (parse_error &) {
+        if (!sync_item(false)) throw;
+      }
     }
-    return expr;
+    expect(TT::RBRACE, "Expected '}' after block.");
+    return nodes.make<ast::block_expr>(std::move(expressions));
   }
 
+  // expression y unary cierran todos los ciclos de la recursion, con pila
+  // segmentada el anidamiento no tiene limite
   ast::expr_ptr expression() {
+    if (internal::stack_exhausted())
+      return internal::grow_stack([&] { return expression(); });
+
     if (match(TT::KW_LET)) return let_expression();
     if (match(TT::KW_IF)) return if_expression();
     if (match(TT::KW_WHILE)) return while_expression();
@@ -323,11 +419,11 @@ struct parser {
     consume(TT::LPAREN, "Expected '(' after for.");
     auto name = consume(TT::IDENTIFIER, "Expected variable name.");
     auto type = opt_type();
-    consume(TT::KW_IN, "Expected 'in' after variable declaration.");
+    expect(TT::KW_IN, "Expected 'in' after variable declaration.");
     ast::expr_ptr iter = expression();
-    consume(TT::RPAREN, "Expected ')' after iterator expression.");
+    expect(TT::RPAREN, "Expected ')' after iterator expression.");
     ast::expr_ptr body = expression();
-    return std::make_unique<ast::for_expr>(name, type, std::move(iter),
+    return nodes.make<ast::for_expr>(name, type, std::move(iter),
                                            std::move(body));
   }
 
@@ -340,28 +436,28 @@ struct parser {
 
       ast::expr_ptr init = match(TT::OP_ASSIGN)
                                ? expression()
-                               : std::make_unique<ast::literal_expr>(nullptr);
+                               : nodes.make<ast::literal_expr>(nullptr);
 
       decl.push_back(
-          std::make_unique<ast::declaration_expr>(name, type, std::move(init)));
+          nodes.make<ast::declaration_expr>(name, type, std::move(init)));
     } while (match(TT::COMMA));
 
-    consume(TT::KW_IN, "Expected 'in' after variable declarations in let-in.");
+    expect(TT::KW_IN, "Expected 'in' after variable declarations in let-in.");
 
     ast::expr_ptr body = expression();
 
-    return std::make_unique<ast::let_expr>(std::move(decl), std::move(body));
+    return nodes.make<ast::let_expr>(std::move(decl), std::move(body));
   }
 
   ast::expr_ptr assignment() {
-    auto expr = or_expr();
+    auto expr = binary_expression();
     if (match(TT::OP_DESTRUCT_ASSIGN)) {
       const auto equals = previous();
       auto value = assignment();
 
-      if (ast::var_expr *t = dynamic_cast<ast::var_expr *>(expr.get())) {
+      if (ast::var_expr *t = dynamic_cast<ast::var_expr *>(expr)) {
         lexer::token type;
-        return std::make_unique<ast::assign_expr>(std::move(expr), type, std::move(value));
+        return nodes.make<ast::assign_expr>(std::move(expr), type, std::move(value));
       }
 
       error(equals, "Invalid assignment target.");
@@ -369,57 +465,31 @@ struct parser {
     return expr;
   }
 
-  ast::expr_ptr or_expr() {
-    ast::expr_ptr expr = and_expr();
-    while (match(TT::OP_OR)) {
-      auto token = previous();
-      auto right = and_expr();
-
-      expr = std::make_unique<ast::binary_expr>(
-          std::move(expr), token, ast::binary_op::OR, std::move(right));
-    }
-    return expr;
-  }
-
-  ast::expr_ptr and_expr() {
-    auto expr = equality();
-    while (match(TT::OP_AND)) {
-      auto token = previous();
-      auto right = equality();
-      expr = std::make_unique<ast::binary_expr>(
-          std::move(expr), token, ast::binary_op::AND, std::move(right));
+  // Operadores binarios por precedencia (Pratt): se lee un operando y se
+  // siguen tomando operadores mientras tengan al menos min_precedence. El
+  // operando derecho solo toma operadores de mas precedencia, asi que
+  // a - b - c queda (a - b) - c como con una funcion por nivel.
+  ast::expr_ptr binary_expression(uint8_t min_precedence = 1) {
+    ast::expr_ptr expr = unary();
+    for (;;) {
+      uint8_t precedence = binary_precedence[peek().get_type()];
+      if (precedence < min_precedence) return expr;  // 0: no es operador
+
+      lexer::token token = advance();
+      ast::expr_ptr right = binary_expression(precedence + 1);
+      expr = nodes.make<ast::binary_expr>(
+          expr, token, static_cast<ast::binary_op>(token.get_type()), right);
     }
-    return expr;
-  }
-
-  ast::expr_ptr equality() {
-    return parse_binary_expr({TT::OP_NOT_EQUAL, TT::OP_EQUAL}, comparison(),
-                             &parser::comparison);
-  }
-
-  ast::expr_ptr comparison() {
-    return parse_binary_expr(
-        {TT::OP_GREATER, TT::OP_GREATER_EQ, TT::OP_LESS, TT::OP_LESS_EQ},
-        term(), &parser::term);
-  }
-
-  ast::expr_ptr term() {
-    return parse_binary_expr({TT::OP_MINUS, TT::OP_PLUS}, factor(),
-                             &parser::factor);
-  }
-
-  ast::expr_ptr factor() {
-    return parse_binary_expr(
-        {TT::OP_DIVIDE, TT::OP_MODULE, TT::OP_MULTIPLY, TT::OP_EXPONENT,
-         TT::OP_CONCAT, TT::OP_DOBLE_CONCAT},
-        unary(), &parser::unary);
   }
 
   ast::expr_ptr unary() {
+    if (internal::stack_exhausted())
+      return internal::grow_stack([&] { return unary(); });
+
     if (match({TT::OP_NOT, TT::OP_MINUS})) {
       const auto token = previous();
       ast::expr_ptr right = unary();
-      return std::make_unique<ast::unary_expr>(
+      return nodes.make<ast::unary_expr>(
           token, static_cast<ast::unary_op>(token.get_type()),
           std::move(right));
     }
@@ -436,7 +506,7 @@ struct parser {
         if(match(TT::LPAREN))
           expr = finish_call(object, name);
         else 
-          expr = std::make_unique<ast::var_expr>(std::move(object), name);
+          expr = nodes.make<ast::var_expr>(std::move(object), name);
     }
 
     return expr;
@@ -451,18 +521,18 @@ struct parser {
       } while (match(TT::COMMA));
     }
 
-    consume(TT::RPAREN, "Expected ')' after arguments.");
+    expect(TT::RPAREN, "Expected ')' after arguments.");
 
-    return std::make_unique<ast::call_expr>(std::move(object), calle, std::move(arguments));
+    return nodes.make<ast::call_expr>(std::move(object), calle, std::move(arguments));
   }
 
   ast::expr_ptr primary() {
-    if (match(TT::FALSE)) return std::make_unique<ast::literal_expr>(false);
-    if (match(TT::TRUE)) return std::make_unique<ast::literal_expr>(true);
-    if (match(TT::T_NULL)) return std::make_unique<ast::literal_expr>(nullptr);
+    if (match(TT::FALSE)) return nodes.make<ast::literal_expr>(false);
+    if (match(TT::TRUE)) return nodes.make<ast::literal_expr>(true);
+    if (match(TT::T_NULL)) return nodes.make<ast::literal_expr>(nullptr);
 
     if (match({TT::NUMBER, TT::STRING})) {
-      return std::make_unique<ast::literal_expr>(previous().get_literal());
+      return nodes.make<ast::literal_expr>(previous().get_literal());
     }
     
     if (match(TT::IDENTIFIER)) {
@@ -472,12 +542,12 @@ struct parser {
       if(match(TT::LPAREN))
         return finish_call(object, name);
       else 
-        return std::make_unique<ast::var_expr>(std::move(object), name);
+        return nodes.make<ast::var_expr>(std::move(object), name);
     }
 
     if (match(TT::LPAREN)) {
       auto expr = expression();
-      consume(TT::RPAREN, "Expected ')' after expression.");
+      expect(TT::RPAREN, "Expected ')' after expression.");
       return expr;
     }
 
@@ -494,41 +564,144 @@ struct parser {
         } while (match(TT::COMMA));
       }
       
-      consume(TT::RPAREN, "Expected ')' after superclass arguments.");
+      expect(TT::RPAREN, "Expected ')' after superclass arguments.");
 
-      return std::make_unique<ast::new_expr>(name, std::move(args));
+      return nodes.make<ast::new_expr>(name, std::move(args));
     }
 
     throw error(peek(), "Expected expression.");
   }
 
-  static parse_error error(const lexer::token &token,
-                           const std::string &message) {
-    internal::error(token, message, "parser");
+  parse_error error(const lexer::token &token, const std::string &message) {
+    if (token.get_type() != TT::UNKNOWN && tokens.position() != last_error)
+      internal::error(token, message, "parser");
+    last_error = tokens.position();
+    if (internal::too_many_errors()) throw parse_aborted();
     return parse_error(message);
   }
 
+  static bool is_declaration(const lexer::token_type type) {
+    return type == TT::KW_FUNCTION || type == TT::KW_TYPE || type == TT::KW_PROTOCOL;
+  }
+
+  // Panic mode para un error en la expresion global: descarta hasta despues
+  // de un ';' o hasta algo que empieza una declaracion o una expresion, sin
+  // contar lo que este dentro de parentesis abiertos mientras se descarta.
+  // Un bloque se parsea (ver skip_block). function, type y protocol no
+  // pueden estar dentro de una expresion: cortan aunque algun parentesis no
+  // haya cerrado.
   void sync() {
-    advance();
+    int depth = 0;
+    while (!is_at_end()) {
+      const TT type = peek().get_type();
+      if (is_declaration(type)) return;
+      if (depth == 0 && (type == TT::KW_LET || type == TT::KW_IF || type == TT::KW_WHILE ||
+                         type == TT::KW_FOR))
+        return;
+
+      advance();
+      if (type == TT::LBRACE && depth == 0) {
+        if (!skip_block()) return;
+      } else if (type == TT::LPAREN || type == TT::LBRACE) ++depth;
+      else if ((type == TT::RPAREN || type == TT::RBRACE) && depth > 0) --depth;
+      else if (type == TT::SEMICOLON && depth == 0) return;
+    }
+  }
 
+  // Panic mode para un error en una function, type o protocol: descarta
+  // hasta el final de esa declaracion, que es el ';' de un cuerpo '=>', su
+  // cuerpo entre llaves (parseado como corresponde, para no perder los
+  // errores de adentro) o la siguiente declaracion. A diferencia de sync no
+  // corta en let/if/while/for: lo que sigue es parte de la declaracion, no
+  // la expresion global.
+  void sync_declaration(const TT kind) {
+    int depth = 0;
+    bool inline_body = false;
     while (!is_at_end()) {
-      if (previous().get_type() == TT::SEMICOLON) return;
-
-      std::vector<lexer::token_type> types = {TT::KW_TYPE,  TT::KW_FUNCTION,
-                                              TT::KW_LET,   TT::KW_IF,
-                                              TT::KW_WHILE, TT::KW_FOR};
-      for (auto &type : types) {
-        if (check(type)) {
-          return;
-        }
+      const TT type = peek().get_type();
+      if (is_declaration(type)) return;
+
+      advance();
+      if (type == TT::ARROW && depth == 0) inline_body = true;
+      else if (type == TT::LBRACE && depth == 0 && !inline_body) {
+        skip_body(kind);
+        return;
+      } else if (type == TT::LPAREN || type == TT::LBRACE) ++depth;
+      else if ((type == TT::RPAREN || type == TT::RBRACE) && depth > 0) --depth;
+      else if (type == TT::SEMICOLON && depth == 0) return;
+    }
+  }
+
+  // Cuerpo entre llaves de una declaracion con error (ya se consumio la '{')
+  void skip_body(const TT kind) {
+    try {
+      if (kind == TT::KW_TYPE) {
+        std::vector<ast::field_stmt_ptr> fields;
+        std::vector<ast::function_stmt_ptr> methods;
+        class_body(fields, methods);
+      } else if (kind == TT::KW_PROTOCOL) {
+        protocol_body();
+      } else {
+        block_expression();
       }
+    } catch (parse_error &) {
+      // no cerro antes de la siguiente declaracion
+    }
+  }
+
+  // Panic mode dentro de un bloque o del cuerpo de un type/protocol:
+  // descarta hasta despues del ';' que termina el elemento (o del bloque de
+  // su cuerpo si braces_end_item) o hasta la '}' que cierra el bloque, sin
+  // consumirla. Devuelve false si antes aparece una declaracion: el bloque
+  // nunca cerro y se recupera en el nivel de afuera.
+  bool sync_item(bool braces_end_item) {
+    int depth = 0;
+    while (!is_at_end()) {
+      const TT type = peek().get_type();
+      if (depth == 0 && type == TT::RBRACE) return true;
+      if (is_declaration(type)) return false;
 
       advance();
+      if (type == TT::LBRACE && depth == 0) {
+        if (!skip_block()) return false;
+        if (braces_end_item) return true;
+      } else if (type == TT::LPAREN || type == TT::LBRACE) ++depth;
+      else if ((type == TT::RPAREN || type == TT::RBRACE) && depth > 0) --depth;
+      else if (type == TT::SEMICOLON && depth == 0) return true;
+    }
+    return true;
+  }
+
+  // Un bloque que aparece mientras se descarta (ya se consumio la '{') se
+  // parsea igual, con su propia recuperacion, para no perder los errores
+  // de adentro. false si no cerro antes de una declaracion.
+  bool skip_block() {
+    try {
+      block_expression();
+      return true;
+    } catch (parse_error &) {
+      return false;
     }
   }
 
-  lexer::token consume(const lexer::token_type type,
-                       const std::string &message) {
+  // Como consume, pero si falta un cierre que se puede dar por puesto lo
+  // reporta y sigue (devuelve el token donde deberia estar)
+  lexer::token expect(const lexer::token_type type, const std::string &message) {
+    if (check(type)) return advance();
+
+    const TT next = peek().get_type();
+    const bool closer = next == TT::SEMICOLON || next == TT::RPAREN || next == TT::RBRACE ||
+                        next == TT::COMMA || next == TT::KW_IN || next == TT::KW_ELSE ||
+                        next == TT::KW_ELIF || next == TT::END_OF_FILE;
+    if (!closer && peek().get_location().first == previous().get_location().first)
+      throw error(peek(), message);
+
+    error(peek(), message);
+    return peek();
+  }
+
+  const lexer::token &consume(const lexer::token_type type,
+                              const std::string &message) {
     if (check(type)) return advance();
     throw error(peek(), message);
   }
@@ -550,17 +723,14 @@ struct parser {
     return !is_at_end() && peek().get_type() == type;
   }
 
-  lexer::token advance() {
-    if (!is_at_end()) current++;
-    return previous();
-  }
+  // devuelven referencias al buffer del token_stream: validas hasta pedir
+  // otro token, quien lo guarde tiene que copiarlo
+  const lexer::token &advance() { return tokens.next(); }
 
-  bool is_at_end() {
-    return peek().get_type() == lexer::token_type::END_OF_FILE;
-  }
+  bool is_at_end() { return tokens.at_end(); }
 
-  lexer::token peek() { return tokens.at(current); }
-  lexer::token previous() { return tokens.at(current - 1); }
+  const lexer::token &peek() { return tokens.peek(); }
+  const lexer::token &previous() { return tokens.previous(); }
 };
 
 }  // namespace parser
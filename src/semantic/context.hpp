@@ -6,18 +6,30 @@
 #include <map>
 #include <set>
 #include "type.hpp"
+#include "../ast/arena.hpp"
+#include "../lexer/symbols.hpp"
 using namespace std;
 
 namespace hulk {
     namespace semantic {
 
+        struct prelude;
+
         struct context {
-            map<string, type> types;
+            type_table types;
             map<string, method> functions;
 
-            map<string, vector<string>> variable_scope;
+            // indexed by the variable's symbol, each entry is the stack of
+            // types of the nested declarations with that name
+            vector<vector<string>> variable_scope;
             string self;
 
+            // arena of the program being analyzed, for the nodes the passes add
+            ast::ast_arena* nodes = nullptr;
+
+            // standard library declared before the program, if any
+            prelude* lib = nullptr;
+
             context() = default;
 
             bool create_protocol(const string& protocol_name) {
@@ -27,44 +39,82 @@ namespace hulk {
             }
 
             bool is_protocol(const string& protocol_name) {
-                if (types[protocol_name].is_protocol)
-                    return true;
-                return false;
+                return get_type(protocol_name).is_protocol;
             }
 
             bool create_type(const string& type_name, bool is_protocol = false) {
-                if (types.find(type_name) != types.end()) {
-                    return false; // Type already exists
-                }
-                types[type_name] = type(type_name, is_protocol);
-                return true;
+                return types.add(type_name, is_protocol) != no_type;
             }
 
             bool type_exists(const string& type_name) const {
-                return types.find(type_name) != types.end();
+                return types.find(type_name) != no_type;
+            }
+
+            // no_type if there is no type with that name
+            type_id get_type_id(const string& type_name) const {
+                return types.find(type_name);
             }
 
             // Use type_exists to check if the type exists before getting it
+            // (a missing one is created empty)
             type& get_type(const string& type_name) {
-                return types[type_name];
+                type_id id = types.find(type_name);
+                if (id == no_type)
+                    id = types.add(type_name);
+                return types[id];
+            }
+
+            type& get_type(type_id id) {
+                return types[id];
+            }
+
+            const string& type_name(type_id id) const {
+                return types.name(id);
+            }
+
+            bool conforms(type_id t, type_id other) const {
+                return types.conforms(t, other);
             }
 
-            type* get_lca_type(type* t1, type* t2) {
-                if (*t1 <= *t2)
+            bool conforms(const string& t, const string& other) const {
+                return conforms(get_type_id(t), get_type_id(other));
+            }
+
+            bool has_method(type_id t, const string& method_name) const {
+                return types.has_method(t, method_name);
+            }
+
+            method& get_method(type_id t, const string& method_name) {
+                return types.get_method(t, method_name);
+            }
+
+            type_id get_lca_type(type_id t1, type_id t2) {
+                if (types.in_class_tree(t1) && types.in_class_tree(t2)) {
+                    type_id lca = types.common_ancestor(t1, t2);
+                    return lca != no_type ? lca : get_type_id("Object");
+                }
+
+                // protocols conform structurally, walk the parents
+                if (conforms(t1, t2))
                     return t2;
-                if (*t2 <= *t1)
+                if (conforms(t2, t1))
                     return t1;
                 // Find the least common ancestor (LCA) of two types
 
-                type_ptr lca = t1->parent;
-                while (lca) {
-                    if (*t2 <= *lca) {
-                        return lca.get(); // Found LCA
+                type_id lca = t1 == no_type ? no_type : types[t1].parent;
+                while (lca != no_type) {
+                    if (conforms(t2, lca)) {
+                        return lca; // Found LCA
                     }
-                    lca = lca->parent;
+                    lca = types[lca].parent;
                 }
 
-                return &get_type("Object"); // No common ancestor found
+                return get_type_id("Object"); // No common ancestor found
+            }
+
+            // Same, by name
+            const string& get_lca_type(const string& t1, const string& t2) {
+                return type_name(get_lca_type(get_type_id(t1), get_type_id(t2)));
             }
 
             bool create_function(const string& func_name) {
@@ -83,22 +133,29 @@ namespace hulk {
                 return functions[func_name];
             }
 
-            void add_variable(const string& var_name, const string& type_name = "") {
-                variable_scope[var_name].push_back(type_name);
+            void add_variable(lexer::symbol var_name, const string& type_name = "") {
+                scope_of(var_name).push_back(type_name);
             }
 
-            void rollback_variable(const string& var_name) {
-                variable_scope[var_name].pop_back();
+            void rollback_variable(lexer::symbol var_name) {
+                scope_of(var_name).pop_back();
             }
 
-            bool variable_exists(const string& var_name) {
-                if (variable_scope[var_name].empty())
+            bool variable_exists(lexer::symbol var_name) {
+                if (scope_of(var_name).empty())
                     return false;
                 return true;
             }
 
-            string& get_variable_type(const string& var_name) {
-                return variable_scope[var_name].back();
+            string& get_variable_type(lexer::symbol var_name) {
+                return scope_of(var_name).back();
+            }
+
+        private:
+            vector<string>& scope_of(lexer::symbol var_name) {
+                if (var_name >= variable_scope.size())
+                    variable_scope.resize(var_name + 1);
+                return variable_scope[var_name];
             }
         };
         
@@ -0,0 +1,386 @@
+#ifndef HULK_SEMANTIC_PRELUDE_HPP
+#define HULK_SEMANTIC_PRELUDE_HPP 1
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include "context.hpp"
+#include "type.hpp"
+#include "../ast/ast"
+#include "../ast/flat"
+#include "../ast/serialize"
+#include "../internal/internal_uncopyable"
+#include "../internal/internal_util"
+#include "../lexer/source"
+#include "../lexer/symbols"
+#include "../parser/parser"
+
+namespace hulk {
+    namespace semantic {
+
+        // Sections the prelude adds to the AST image
+        enum prelude_section : uint32_t {
+            TYPES = ast::ast_sections,
+            ATTRIBUTES,
+            METHODS,
+            GLOBAL_FUNCTIONS,
+            DECLARED_NAMES,  // one per statement of the image
+            DEPENDENCIES,
+            prelude_sections
+        };
+
+        // Type references are stored by name, ast::no_string for none
+        struct attribute_record {
+            uint32_t name;
+            uint32_t type;
+        };
+
+        struct method_record {
+            uint32_t name;
+            uint32_t return_type;
+            ast::node_range params;  // in ATTRIBUTES
+        };
+
+        struct type_record {
+            uint32_t name;
+            uint32_t parent;
+            uint32_t is_protocol;
+            ast::node_range params, fields;  // in ATTRIBUTES
+            ast::node_range methods;         // in METHODS
+        };
+
+        struct declaration_record {
+            uint32_t name;
+            ast::node_range dependencies;  // other statements it names, in DEPENDENCIES
+        };
+
+        // Name a statement declares, empty for expressions
+        string declared_name(const ast::stmt* s) {
+            if (auto* f = dynamic_cast<const ast::function_stmt*>(s)) return f->name.get_lexeme();
+            if (auto* c = dynamic_cast<const ast::class_stmt*>(s)) return c->name.get_lexeme();
+            if (auto* p = dynamic_cast<const ast::protocol_stmt*>(s)) return p->name.get_lexeme();
+            return "";
+        }
+
+        // Standard library (lib.hulk) shared by every program.
+        //
+        // It is lexed, parsed and analyzed once; the analyzed declarations
+        // (ast::flat_program) and the types and functions they add to the
+        // context are written to a binary image in cache_path, keyed by a
+        // hash of the library text. Later runs map the image and skip all
+        // of that unless the library changed. The context entries are
+        // declared before the program's own (declare, from the context
+        // builder) and the nodes of a declaration are only built if the
+        // program names it, directly or through another declaration it
+        // uses (link, before code generation). A program can redefine a
+        // library name; its own declaration wins.
+        struct prelude : private internal::uncopyable {
+            // Call after parsing the program: symbols interned so far are
+            // the program's names
+            prelude(const string& source_path, const string& cache_path)
+                : known(lexer::symbols().size()) {
+                std::optional<lexer::source_file> source;
+                try {
+                    source.emplace(source_path);
+                }
+                catch (const std::runtime_error&) {
+                    return;  // no library
+                }
+                const uint64_t key = internal::content_hash(source->text());
+
+                try {
+                    cache.emplace(cache_path);
+                    if (open(cache->text(), key))
+                        return;
+                    cache.reset();
+                }
+                catch (const std::runtime_error&) {
+                }
+
+                built = build(source->text(), key);
+                if (built.empty() || !open(built, key))
+                    return;
+
+                // written next to the output; if that fails it is rebuilt next
+                // time. The temporary is per process so that compiles running
+                // at the same time never write to the same one.
+                std::string temporary = cache_path + "." + std::to_string(getpid()) + ".tmp";
+                std::ofstream out(temporary, std::ios::binary);
+                out.write(built.data(), static_cast<std::streamsize>(built.size()));
+                out.close();
+                if (!out || std::rename(temporary.c_str(), cache_path.c_str()) != 0)
+                    std::remove(temporary.c_str());
+            }
+
+            // Add the library types and functions to ctx, except the ones
+            // statements declare
+            void declare(context& ctx, const vector<ast::stmt_ptr>& statements) {
+                if (!valid)
+                    return;
+
+                set<string> own;
+                for (const auto& stmt : statements)
+                    own.insert(declared_name(stmt));
+
+                shadowed.assign(names.size(), false);
+                for (size_t i = 0; i < names.size(); ++i)
+                    shadowed[i] = own.count(string(nodes.string(names[i].name))) > 0;
+
+                // every type first, so that they can refer to each other
+                vector<type_id> declared(types.size(), no_type);
+                for (size_t i = 0; i < types.size(); ++i) {
+                    string type_name(nodes.string(types[i].name));
+                    if (!own.count(type_name))
+                        declared[i] = ctx.types.add(type_name, types[i].is_protocol);
+                }
+
+                for (size_t i = 0; i < types.size(); ++i) {
+                    if (declared[i] == no_type)
+                        continue;
+
+                    const type_record& record = types[i];
+                    auto& t = ctx.get_type(declared[i]);
+                    for (const auto& param : attributes(record.params))
+                        t.add_param(string(nodes.string(param.name)), reference(ctx, param.type));
+                    if (record.parent != ast::no_string)
+                        t.add_parent(reference(ctx, record.parent));
+                    for (const auto& field : attributes(record.fields))
+                        t.add_field(string(nodes.string(field.name)), reference(ctx, field.type));
+                    for (uint32_t i = 0; i < record.methods.count; ++i)
+                        t.add_method(function(ctx, methods[record.methods.first + i]));
+                }
+
+                for (const auto& record : functions) {
+                    string function_name(nodes.string(record.name));
+                    if (own.count(function_name) || !ctx.create_function(function_name))
+                        continue;
+                    ctx.get_function(function_name) = function(ctx, record);
+                }
+            }
+
+            // Put the declarations the program uses in front of its
+            // statements, built in its arena
+            void link(ast::program& program) const {
+                if (!valid)
+                    return;
+
+                vector<bool> used(names.size(), false);
+                vector<size_t> pending;
+                for (size_t i = 0; i < names.size(); ++i)
+                    if (lexer::intern(nodes.string(names[i].name)) < known)
+                        pending.push_back(i);
+
+                while (!pending.empty()) {
+                    size_t i = pending.back();
+                    pending.pop_back();
+                    if (used[i] || (i < shadowed.size() && shadowed[i]))
+                        continue;
+                    used[i] = true;
+                    for (uint32_t d = 0; d < names[i].dependencies.count; ++d)
+                        pending.push_back(dependencies[names[i].dependencies.first + d]);
+                }
+
+                vector<ast::stmt_ptr> linked;
+                for (size_t i = 0; i < names.size(); ++i)
+                    if (used[i])
+                        linked.push_back(nodes.statement(i, program.arena));
+                program.statements.insert(program.statements.begin(), linked.begin(), linked.end());
+            }
+
+        private:
+            lexer::symbol known = 0;
+            std::optional<lexer::source_file> cache;
+            std::string built;  // image, when the cache was stale
+            bool valid = false;
+
+            ast::image_reader image;
+            ast::flat_image nodes;
+            ast::array_view<type_record> types;
+            ast::array_view<attribute_record> attribute_pool;
+            ast::array_view<method_record> methods;
+            ast::array_view<method_record> functions;
+            ast::array_view<declaration_record> names;
+            ast::array_view<uint32_t> dependencies;
+            vector<bool> shadowed;
+
+            bool open(std::string_view bytes, uint64_t key) {
+                if (!image.open(bytes, key, prelude_sections))
+                    return false;
+                nodes = ast::flat_image(image);
+                types = image.section<type_record>(TYPES);
+                attribute_pool = image.section<attribute_record>(ATTRIBUTES);
+                methods = image.section<method_record>(METHODS);
+                functions = image.section<method_record>(GLOBAL_FUNCTIONS);
+                names = image.section<declaration_record>(DECLARED_NAMES);
+                dependencies = image.section<uint32_t>(DEPENDENCIES);
+                valid = names.size() == nodes.statements.size() && nodes.valid() && records_valid();
+                return valid;
+            }
+
+            // Every index the records hold is inside its section; a damaged
+            // cache is rebuilt like a stale one
+            bool records_valid() const {
+                auto name = [&](uint32_t id) { return nodes.has_string(id); };
+                auto type_name = [&](uint32_t id) { return id == ast::no_string || nodes.has_string(id); };
+                auto attributes_in = [&](ast::node_range range) {
+                    return ast::in_bounds(range, attribute_pool.size());
+                };
+                auto method_valid = [&](const method_record& m) {
+                    return name(m.name) && type_name(m.return_type) && attributes_in(m.params);
+                };
+
+                for (const auto& a : attribute_pool)
+                    if (!name(a.name) || !type_name(a.type))
+                        return false;
+                for (const auto& t : types) {
+                    uint8_t is_protocol;
+                    std::memcpy(&is_protocol, &t.is_protocol, 1);
+                    if (!name(t.name) || !type_name(t.parent) || is_protocol > 1 || !attributes_in(t.params) ||
+                        !attributes_in(t.fields) || !ast::in_bounds(t.methods, methods.size()))
+                        return false;
+                }
+                for (const auto& m : methods)
+                    if (!method_valid(m))
+                        return false;
+                for (const auto& f : functions)
+                    if (!method_valid(f))
+                        return false;
+                for (const auto& d : names)
+                    if (!name(d.name) || !ast::in_bounds(d.dependencies, dependencies.size()))
+                        return false;
+                for (uint32_t d : dependencies)
+                    if (d >= names.size())
+                        return false;
+                return true;
+            }
+
+            ast::array_view<attribute_record> attributes(ast::node_range range) const {
+                return { attribute_pool.items + range.first, range.count };
+            }
+
+            // no_type for none, or for a type the program itself declares
+            // (the context builder has not added it yet)
+            type_id reference(context& ctx, uint32_t name) const {
+                if (name == ast::no_string)
+                    return no_type;
+                return ctx.get_type_id(string(nodes.string(name)));
+            }
+
+            method function(context& ctx, const method_record& record) const {
+                method m(string(nodes.string(record.name)), reference(ctx, record.return_type));
+                for (const auto& param : attributes(record.params))
+                    m.add_param(string(nodes.string(param.name)), reference(ctx, param.type));
+                return m;
+            }
+
+            // Lex, parse and analyze the library and write its image; empty
+            // if it has errors (they are reported as usual)
+            static std::string build(std::string_view text, uint64_t key) {
+                lexer::token_stream tokens(text);
+                ast::program library = parser::parser(tokens).parse();
+                if (internal::error_found)
+                    return "";
+
+                context ctx;
+                library.context_builder_visit(ctx);
+                if (!internal::error_found)
+                    library.scoped_visit(ctx);
+                if (!internal::error_found)
+                    library.infer(ctx);
+                if (!internal::error_found)
+                    library.type_check(ctx);
+                if (internal::error_found)
+                    return "";
+
+                // only declarations; a global expression in the library is ignored
+                vector<ast::stmt_ptr> declarations;
+                vector<string> declaration_names;
+                for (const auto& stmt : library.statements) {
+                    string name = declared_name(stmt);
+                    if (!name.empty()) {
+                        declarations.push_back(stmt);
+                        declaration_names.push_back(name);
+                    }
+                }
+
+                // flattened one by one to know which tokens each one has
+                ast::flat_program flat;
+                ast::flattener flattener{ flat };
+                vector<pair<size_t, size_t>> token_ranges;
+                for (const auto& stmt : declarations) {
+                    size_t first = flat.tokens.size();
+                    flattener.statement(stmt);
+                    token_ranges.emplace_back(first, flat.tokens.size());
+                }
+
+                ast::image_writer writer;
+                writer.write(flat);
+
+                auto name_of = [&](type_id t) {
+                    return t == no_type ? ast::no_string : writer.string(ctx.type_name(t));
+                };
+
+                vector<attribute_record> attribute_records;
+                auto add_attributes = [&](const vector<attribute>& attrs) {
+                    ast::node_range range{ static_cast<uint32_t>(attribute_records.size()), static_cast<uint32_t>(attrs.size()) };
+                    for (const auto& a : attrs)
+                        attribute_records.push_back({ writer.string(a.name), name_of(a.attr_type) });
+                    return range;
+                };
+                auto method_of = [&](const method& m) {
+                    return method_record{ writer.string(m.name), name_of(m.return_type), add_attributes(m.params) };
+                };
+
+                vector<type_record> type_records;
+                vector<method_record> method_records, function_records;
+                vector<declaration_record> declaration_records;
+                vector<uint32_t> dependency_records;
+                for (size_t i = 0; i < declarations.size(); ++i) {
+                    const string& name = declaration_names[i];
+
+                    if (dynamic_cast<const ast::function_stmt*>(declarations[i])) {
+                        function_records.push_back(method_of(ctx.get_function(name)));
+                    }
+                    else {
+                        type& t = ctx.get_type(name);
+                        ast::node_range params = add_attributes(t.params);
+                        ast::node_range fields = add_attributes(t.fields);
+                        ast::node_range methods_range{ static_cast<uint32_t>(method_records.size()), static_cast<uint32_t>(t.methods.size()) };
+                        for (const auto& m : t.methods)
+                            method_records.push_back(method_of(m));
+                        type_records.push_back({ writer.string(name), name_of(t.parent), t.is_protocol, params, fields, methods_range });
+                    }
+
+                    // the other declarations whose name appears in this one
+                    set<uint32_t> uses;
+                    for (size_t k = token_ranges[i].first; k < token_ranges[i].second; ++k)
+                        for (size_t j = 0; j < declarations.size(); ++j)
+                            if (j != i && flat.tokens[k].lexeme == declaration_names[j])
+                                uses.insert(static_cast<uint32_t>(j));
+
+                    ast::node_range range{ static_cast<uint32_t>(dependency_records.size()), static_cast<uint32_t>(uses.size()) };
+                    dependency_records.insert(dependency_records.end(), uses.begin(), uses.end());
+                    declaration_records.push_back({ writer.string(name), range });
+                }
+
+                writer.section(TYPES, type_records);
+                writer.section(ATTRIBUTES, attribute_records);
+                writer.section(METHODS, method_records);
+                writer.section(GLOBAL_FUNCTIONS, function_records);
+                writer.section(DECLARED_NAMES, declaration_records);
+                writer.section(DEPENDENCIES, dependency_records);
+                return writer.finish(key);
+            }
+        };
+
+    } // namespace semantic
+} // namespace hulk
+
+#endif // HULK_SEMANTIC_PRELUDE_HPP
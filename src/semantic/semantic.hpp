@@ -2,14 +2,16 @@
 #define HULK_SEMANTIC_HPP 1
 
 #include "context.hpp"
+#include "prelude.hpp"
 #include "visitors"
 #include "../ast/ast"
 
 namespace hulk {
     namespace semantic {
 
-        int analyze(const ast::program& program) {
+        int analyze(const ast::program& program, prelude* lib = nullptr) {
             context ctx;
+            ctx.lib = lib;
 
             program.context_builder_visit(ctx);
             if (internal::error_found) {
@@ -39,6 +41,9 @@ namespace hulk {
 
             std::cerr << "Type checking completed successfully." << std::endl;
 
+            std::cerr << "Protocol conformance cache: " << ctx.types.conformance_hits() << " hits, "
+                << ctx.types.conformance_misses() << " misses." << std::endl;
+
             return 0;
         }
 
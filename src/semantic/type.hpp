@@ -1,45 +1,47 @@
 #ifndef HULK_SEMANTIC_TYPE_HPP
 #define HULK_SEMANTIC_TYPE_HPP 1
 
+#include <cstdint>
+#include <deque>
+#include <limits>
 #include <string>
+#include <unordered_map>
 #include <vector>
-#include <memory>
 using namespace std;
 
 namespace hulk {
     namespace semantic {
 
-        // Forward declarations
-        struct attribute;
-        struct method;
-        struct type;
-
-        using type_ptr = shared_ptr<type>;
+        // Types are numbered densely in the order they are created. Parents,
+        // attribute types and return types refer to the one record of a type
+        // in the type_table by its id instead of keeping copies of it.
+        using type_id = uint32_t;
+        constexpr type_id no_type = numeric_limits<type_id>::max();
 
         struct attribute {
             string name;
-            type_ptr attr_type;
+            type_id attr_type = no_type;
 
             attribute() = default;
 
-            attribute(const string& attr_name, const type_ptr& attr_type = nullptr)
+            attribute(const string& attr_name, type_id attr_type = no_type)
                 : name(attr_name), attr_type(attr_type) {
             }
         };
 
         struct method {
             string name;
-            type_ptr return_type;
+            type_id return_type = no_type;
             vector<attribute> params;
 
             method() = default;
 
-            method(const string& method_name, const type_ptr& return_type = nullptr)
+            method(const string& method_name, type_id return_type = no_type)
                 : name(method_name), return_type(return_type) {
             }
 
             // Define a parameter for the method
-            bool add_param(const string& param_name, const type_ptr& param_type = nullptr) {
+            bool add_param(const string& param_name, type_id param_type = no_type) {
                 for (const auto& param : params)
                     if (param.name == param_name)
                         return false; // Parameter already exists
@@ -58,55 +60,19 @@ namespace hulk {
         };
 
         struct type {
+            type_id id = no_type;
             string name;
             vector<attribute> params;
             vector<attribute> fields;
             vector<method> methods;
-            type_ptr parent;
+            type_id parent = no_type;
             bool is_protocol;
 
-            type(const string& type_name = "", bool _is_protocol = false)
-                : name(type_name), is_protocol(_is_protocol) {
-            }
-
-            bool operator==(const type& other) const {
-                return name == other.name;
-            }
-
-            bool operator!=(const type& other) const {
-                return !(*this == other);
-            }
-
-            bool operator<=(const type& other) const {
-                if (*this == other) return true;
-
-                if (other.is_protocol) {
-                    bool conforms = true;
-
-                    for (const auto& method : other.methods) {
-                        if (!has_method(method.name))
-                            return false; // If any method in 'proto' is not in 'this', return false
-
-                        auto& this_method = get_method(method.name);
-                        conforms &= this_method.return_type <= method.return_type;
-
-                        if (this_method.params.size() != method.params.size())
-                            return false; // If the number of parameters doesn't match, return false
-
-                        for (size_t i = 0; i < this_method.params.size(); ++i)
-                            conforms &= method.params[i].attr_type <= this_method.params[i].attr_type;
-                    }
-
-                    return conforms;
-                }
-
-                if (*parent <= other)
-                    return true;
-
-                return false;
+            type(const string& type_name = "", bool _is_protocol = false, type_id _id = no_type)
+                : id(_id), name(type_name), is_protocol(_is_protocol) {
             }
 
-            bool add_param(const string& param_name, const type_ptr& param_type = nullptr) {
+            bool add_param(const string& param_name, type_id param_type = no_type) {
                 for (const auto& param : params)
                     if (param.name == param_name)
                         return false; // Parameter already exists
@@ -115,15 +81,15 @@ namespace hulk {
                 return true;
             }
 
-            bool add_parent(type_ptr parent_type) {
-                if (parent)
+            bool add_parent(type_id parent_type) {
+                if (parent != no_type)
                     return false; // Parent already exists
 
                 parent = parent_type;
                 return true;
             }
 
-            bool add_field(const string& field_name, const type_ptr& field_type = nullptr) {
+            bool add_field(const string& field_name, type_id field_type = no_type) {
                 for (const auto& field : fields)
                     if (field.name == field_name)
                         return false; // Field already exists
@@ -157,38 +123,260 @@ namespace hulk {
                 return true;
             }
 
-            bool has_method(const string& method_name) const {
-                for (const auto& method : methods)
+            // Method declared by this type itself (inherited ones are looked
+            // up through the type_table), nullptr if there is none
+            method* own_method(const string& method_name) {
+                for (auto& method : methods)
                     if (method.name == method_name)
-                        return true;
+                        return &method;
 
-                if (parent)
-                    return parent->has_method(method_name);
+                return nullptr;
+            }
 
-                return false;
+            const method* own_method(const string& method_name) const {
+                return const_cast<type*>(this)->own_method(method_name);
             }
+        };
 
-            method& get_method(const string& method_name) {
-                for (auto& method : methods)
-                    if (method.name == method_name)
-                        return method;
+        // Every type of a program, once. Records never move (references to
+        // them stay valid while types are added) and names are hashed, so
+        // both kinds of lookup are O(1).
+        struct type_table {
+            // Id of the new type, no_type if the name is already taken
+            type_id add(const string& type_name, bool is_protocol = false) {
+                if (ids.count(type_name))
+                    return no_type;
+                type_id id = static_cast<type_id>(types.size());
+                types.emplace_back(type_name, is_protocol, id);
+                ids.emplace(type_name, id);
+                if (!enter.empty()) {
+                    // created after numbering (it has no parent yet): a new root
+                    enter.push_back(next_number++);
+                    leave.push_back(next_number++);
+                    for (auto& level : ancestors)
+                        level.push_back(id);
+                    class_chain.push_back(!is_protocol);
+                }
+                return id;
+            }
 
-                if (parent)
-                    return parent->get_method(method_name);
+            // Number the inheritance forest in depth first order, once the
+            // parents are known (the context builder does it when it ends;
+            // parents must not change afterwards). A type then descends from
+            // another iff its [enter, leave] interval lies inside the other's,
+            // and ancestors[k][t] (the 2^k-th ancestor of t, or its root)
+            // finds common ancestors in O(log n) steps.
+            void number_hierarchy() {
+                const size_t n = types.size();
+                enter.assign(n, unnumbered);
+                leave.assign(n, unnumbered);
+                class_chain.assign(n, false);
+                size_t levels = 1;
+                while ((size_t(1) << levels) < n)
+                    ++levels;
+                ancestors.assign(levels, vector<type_id>(n, no_type));
+                next_number = 0;
+                conformance.clear();  // inherited methods may have changed
+
+                // children as linked lists, walked without recursion
+                vector<type_id> next_child(n, no_type), next_sibling(n, no_type);
+                for (type_id t = static_cast<type_id>(n); t-- > 0;) {
+                    type_id parent = types[t].parent;
+                    if (parent != no_type) {
+                        next_sibling[t] = next_child[parent];
+                        next_child[parent] = t;
+                    }
+                }
 
-                return *(new method()); // warn: this is dangerous, make sure to check with has_method first
+                vector<type_id> path;
+                auto visit = [&](type_id t, type_id parent) {
+                    enter[t] = next_number++;
+                    ancestors[0][t] = parent == no_type ? t : parent;
+                    for (size_t k = 1; k < levels; ++k)
+                        ancestors[k][t] = ancestors[k - 1][ancestors[k - 1][t]];
+                    class_chain[t] = !types[t].is_protocol && (parent == no_type || class_chain[parent]);
+                    path.push_back(t);
+                };
+
+                // a type in a parent cycle is not reached and stays unnumbered
+                for (type_id root = 0; root < n; ++root) {
+                    if (types[root].parent != no_type)
+                        continue;
+                    visit(root, no_type);
+                    while (!path.empty()) {
+                        type_id t = path.back();
+                        type_id child = next_child[t];
+                        if (child != no_type) {
+                            next_child[t] = next_sibling[child];
+                            visit(child, t);
+                        }
+                        else {
+                            leave[t] = next_number++;
+                            path.pop_back();
+                        }
+                    }
+                }
             }
 
-            const method& get_method(const string& method_name) const {
-                for (const auto& method : methods)
-                    if (method.name == method_name)
-                        return method;
+            // Both numbered and only classes from them to their roots: their
+            // common ancestor is the one of the tree
+            bool in_class_tree(type_id t) const {
+                return numbered(t) && class_chain[t];
+            }
+
+            // Closest type both descend from, no_type if they are in different
+            // trees. Both must be numbered.
+            type_id common_ancestor(type_id a, type_id b) const {
+                if (descends(a, b))
+                    return b;
+                if (descends(b, a))
+                    return a;
+                for (size_t k = ancestors.size(); k-- > 0;)
+                    if (!descends(b, ancestors[k][a]))
+                        a = ancestors[k][a];
+                a = ancestors[0][a];
+                return descends(b, a) ? a : no_type;
+            }
+
+            type_id find(const string& type_name) const {
+                auto it = ids.find(type_name);
+                return it == ids.end() ? no_type : it->second;
+            }
+
+            size_t size() const { return types.size(); }
+
+            type& operator[](type_id id) { return types[id]; }
+            const type& operator[](type_id id) const { return types[id]; }
 
-                if (parent)
-                    return parent->get_method(method_name);
+            // Empty for no_type
+            const string& name(type_id id) const {
+                static const string none;
+                return id == no_type ? none : types[id].name;
+            }
+
+            // The method of t or of its closest ancestor that has it
+            const method* find_method(type_id t, const string& method_name) const {
+                for (; t != no_type; t = types[t].parent)
+                    if (const method* m = types[t].own_method(method_name))
+                        return m;
+                return nullptr;
+            }
+
+            bool has_method(type_id t, const string& method_name) const {
+                return find_method(t, method_name) != nullptr;
+            }
+
+            method& get_method(type_id t, const string& method_name) {
+                if (const method* m = find_method(t, method_name))
+                    return const_cast<method&>(*m);
 
                 return *(new method()); // warn: this is dangerous, make sure to check with has_method first
             }
+
+            // t can be used where other is expected: it is other, descends
+            // from it or, for a protocol, has all of its methods with
+            // compatible signatures
+            bool conforms(type_id t, type_id other) const {
+                if (t == other)
+                    return true;
+                if (t == no_type || other == no_type)
+                    return false;
+
+                if (types[other].is_protocol)
+                    return conforms_to_protocol(t, other);
+
+                if (numbered(t) && numbered(other))
+                    return descends(t, other);
+
+                for (type_id ancestor = types[t].parent; ancestor != no_type; ancestor = types[ancestor].parent)
+                    if (ancestor == other)
+                        return true;
+
+                return false;
+            }
+
+            // Protocol conformance answers are kept by (type, protocol) until
+            // a method signature changes; call this when one does (type
+            // inference filling in return and parameter types)
+            void signatures_changed() {
+                conformance.clear();
+            }
+
+            size_t conformance_hits() const { return hits; }
+            size_t conformance_misses() const { return misses; }
+
+        private:
+            deque<type> types;
+            unordered_map<string, type_id> ids;
+
+            // (type << 32 | protocol) -> t has every method of the protocol
+            // with compatible signatures
+            mutable unordered_map<uint64_t, bool> conformance;
+            mutable vector<uint64_t> pending;  // pairs answered during the current check
+            mutable size_t hits = 0, misses = 0;
+
+            // While a pair is being checked it is assumed to conform, so a
+            // protocol whose methods mention it (directly or through other
+            // protocols) does not recurse forever. If it turns out not to,
+            // the answers found meanwhile may rest on that and are dropped.
+            bool conforms_to_protocol(type_id t, type_id protocol) const {
+                const uint64_t key = uint64_t(t) << 32 | protocol;
+                auto cached = conformance.find(key);
+                if (cached != conformance.end()) {
+                    ++hits;
+                    return cached->second;
+                }
+                ++misses;
+
+                const size_t mark = pending.size();
+                conformance.emplace(key, true);
+                pending.push_back(key);
+
+                bool matches = true;
+                for (const auto& method : types[protocol].methods) {
+                    const semantic::method* this_method = find_method(t, method.name);
+                    if (!this_method || this_method->params.size() != method.params.size()) {
+                        matches = false; // missing, or with another number of parameters
+                        break;
+                    }
+
+                    matches &= signature_conforms(this_method->return_type, method.return_type);
+                    for (size_t i = 0; i < this_method->params.size(); ++i)
+                        matches &= signature_conforms(method.params[i].attr_type, this_method->params[i].attr_type);
+                }
+
+                if (!matches) {
+                    for (size_t i = mark + 1; i < pending.size(); ++i)
+                        conformance.erase(pending[i]);
+                    conformance[key] = false; // false even assuming the rest, so it stays
+                    pending.resize(mark);
+                }
+                else if (mark == 0) {
+                    pending.clear(); // outermost check: nothing is assumed anymore
+                }
+                return matches;
+            }
+
+            // filled by number_hierarchy, empty before
+            static constexpr uint32_t unnumbered = numeric_limits<uint32_t>::max();
+            vector<uint32_t> enter, leave;
+            vector<vector<type_id>> ancestors;
+            vector<bool> class_chain;
+            uint32_t next_number = 0;
+
+            bool numbered(type_id t) const {
+                return t < enter.size() && enter[t] != unnumbered;
+            }
+
+            // t is other or one of its descendants (both numbered)
+            bool descends(type_id t, type_id other) const {
+                return enter[other] <= enter[t] && leave[t] <= leave[other];
+            }
+
+            // a signature type that is not known yet does not rule anything out
+            bool signature_conforms(type_id t, type_id other) const {
+                return t == no_type || other == no_type || conforms(t, other);
+            }
         };
 
     }
@@ -7,36 +7,36 @@ namespace hulk {
     namespace ast {
 
         void function_stmt::context_builder_visit(semantic::context& ctx) {
-            if (!ctx.create_function(name.lexeme)) {
+            if (!ctx.create_function(name.get_lexeme())) {
                 internal::error(name, "Function already exists.");
                 return;
             }
 
-            auto& func = ctx.get_function(name.lexeme);
+            auto& func = ctx.get_function(name.get_lexeme());
 
             if (!return_type.lexeme.empty()) {
-                if (!ctx.type_exists(return_type.lexeme)) {
-                    internal::error(return_type, "return type does not exist in function '" + name.lexeme + "'.");
+                if (!ctx.type_exists(return_type.get_lexeme())) {
+                    internal::error(return_type, "return type does not exist in function '" + name.get_lexeme() + "'.");
                 }
                 else
-                    func.return_type = std::make_shared<semantic::type>(ctx.get_type(return_type.lexeme));
+                    func.return_type = ctx.get_type_id(return_type.get_lexeme());
             }
 
             for (const auto& param : parameters) {
                 bool error = false;
                 if (param.type.lexeme.empty()) {
-                    error = !func.add_param(param.name.lexeme);
+                    error = !func.add_param(param.name.get_lexeme());
                 }
                 else {
-                    if (!ctx.type_exists(param.type.lexeme)) {
-                        internal::error(param.type, "parameter type does not exist in parameter '" + param.name.lexeme + "' in function '" + name.lexeme + "'.");
+                    if (!ctx.type_exists(param.type.get_lexeme())) {
+                        internal::error(param.type, "parameter type does not exist in parameter '" + param.name.get_lexeme() + "' in function '" + name.get_lexeme() + "'.");
                     }
                     else
-                        error = !func.add_param(param.name.lexeme, std::make_shared<semantic::type>(ctx.get_type(param.type.lexeme)));
+                        error = !func.add_param(param.name.get_lexeme(), ctx.get_type_id(param.type.get_lexeme()));
                 }
 
                 if (error) {
-                    internal::error(param.name, "parameter already exists in function '" + name.lexeme + "'.");
+                    internal::error(param.name, "parameter already exists in function '" + name.get_lexeme() + "'.");
                 }
             }
         }
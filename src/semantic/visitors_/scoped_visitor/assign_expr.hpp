@@ -7,6 +7,9 @@ namespace hulk {
     namespace ast {
 
         void assign_expr::scoped_visit(semantic::context& ctx) const {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
             variable->scoped_visit(ctx);
 
             value->scoped_visit(ctx);
@@ -7,6 +7,9 @@ namespace hulk {
     namespace ast {
 
         void binary_expr::scoped_visit(semantic::context& ctx) const {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
             left->scoped_visit(ctx);
             right->scoped_visit(ctx);
         }
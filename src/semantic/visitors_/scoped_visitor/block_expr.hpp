@@ -7,6 +7,9 @@ namespace hulk {
     namespace ast {
 
         void block_expr::scoped_visit(semantic::context& ctx) const {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
             for (const auto& expr : expressions)
                 expr->scoped_visit(ctx);
         }
@@ -7,16 +7,19 @@ namespace hulk {
     namespace ast {
 
         void call_expr::scoped_visit(semantic::context& ctx) const {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
             if (object.has_value()) {
                 object.value()->scoped_visit(ctx);
             }
             else {
-                if (!ctx.function_exists(callee.lexeme)) {
+                if (!ctx.function_exists(callee.get_lexeme())) {
                     internal::error(callee, "Function does not exist.");
                     return;
                 }
 
-                auto& func = ctx.get_function(callee.lexeme);
+                auto& func = ctx.get_function(callee.get_lexeme());
                 if (func.params.size() != arguments.size()) {
                     internal::error(callee, "Function expects " + std::to_string(func.params.size()) + " arguments, but got " + std::to_string(arguments.size()) + ".");
                 }
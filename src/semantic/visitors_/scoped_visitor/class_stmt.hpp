@@ -8,29 +8,30 @@ namespace hulk {
 
         void class_stmt::scoped_visit(semantic::context& ctx) const {
             for (const auto& param : parameters) {
-                if (!param.type.lexeme.empty() && !ctx.type_exists(param.type.lexeme)) {
-                    internal::error(param.type, "Type does not exist in parameter '" + param.name.lexeme + "' in class '" + name.lexeme + "'.");
+                if (!param.type.lexeme.empty() && !ctx.type_exists(param.type.get_lexeme())) {
+                    internal::error(param.type, "Type does not exist in parameter '" + param.name.get_lexeme() + "' in class '" + name.get_lexeme() + "'.");
                 }
-                ctx.add_variable(param.name.lexeme);
+                ctx.add_variable(param.name.id);
             }
 
             if (super_class) {
-                int init_size = super_class->get()->init.size();
-                auto& parent = ctx.get_type(super_class->get()->name.lexeme);
+                int init_size = (*super_class)->init.size();
+                // the closest ancestor with parameters
+                semantic::type* parent = &ctx.get_type((*super_class)->name.get_lexeme());
 
-                while(parent.params.empty()) {
-                    if (parent.parent)
-                        parent = *parent.parent;
+                while (parent->params.empty()) {
+                    if (parent->parent != semantic::no_type)
+                        parent = &ctx.get_type(parent->parent);
                     else
                         break; // No parent, exit the loop
                 }
 
-                if (init_size != parent.params.size()) {
-                    internal::error(super_class->get()->name, "Type '" + super_class->get()->name.lexeme +
-                        "' expects " + std::to_string(parent.params.size()) + " arguments, but got " + std::to_string(init_size) + ".");
+                if (init_size != parent->params.size()) {
+                    internal::error((*super_class)->name, "Type '" + (*super_class)->name.get_lexeme() +
+                        "' expects " + std::to_string(parent->params.size()) + " arguments, but got " + std::to_string(init_size) + ".");
                 }
 
-                for (const auto& arg : super_class->get()->init)
+                for (const auto& arg : (*super_class)->init)
                     arg->scoped_visit(ctx);
             }
 
@@ -39,9 +40,9 @@ namespace hulk {
             }
 
             for (const auto& param : parameters)
-                ctx.rollback_variable(param.name.lexeme);
+                ctx.rollback_variable(param.name.id);
 
-            ctx.self = name.lexeme;
+            ctx.self = name.get_lexeme();
 
             for (const auto& method : methods) {
                 method->scoped_visit(ctx);
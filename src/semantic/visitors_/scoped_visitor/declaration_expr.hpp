@@ -7,15 +7,18 @@ namespace hulk {
     namespace ast {
 
         void declaration_expr::scoped_visit(semantic::context& ctx) const {
-            if (!type.lexeme.empty() && !ctx.type_exists(type.lexeme)) {
-                internal::error(type, "Type does not exist in declaration '" + name.lexeme + "'.");
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
+            if (!type.lexeme.empty() && !ctx.type_exists(type.get_lexeme())) {
+                internal::error(type, "Type does not exist in declaration '" + name.get_lexeme() + "'.");
             }
 
             if (value) {
                 value->scoped_visit(ctx);
             }
 
-            ctx.add_variable(name.lexeme, type.lexeme);
+            ctx.add_variable(name.id, type.get_lexeme());
         }
 
     } // namespace ast
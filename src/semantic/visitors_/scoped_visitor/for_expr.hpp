@@ -7,19 +7,22 @@ namespace hulk {
     namespace ast {
 
         void for_expr::scoped_visit(semantic::context& ctx) const {
-            if (!var_type.lexeme.empty() && !ctx.type_exists(var_type.lexeme)) {
-                internal::error(var_type, "Type does not exist in for loop variable '" + var_name.lexeme + "'.");
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
+            if (!var_type.lexeme.empty() && !ctx.type_exists(var_type.get_lexeme())) {
+                internal::error(var_type, "Type does not exist in for loop variable '" + var_name.get_lexeme() + "'.");
             }
 
             iterable->scoped_visit(ctx);
 
-            ctx.add_variable(var_name.lexeme);
+            ctx.add_variable(var_name.id);
 
             if (body) {
                 body->scoped_visit(ctx);
             }
 
-            ctx.rollback_variable(var_name.lexeme);
+            ctx.rollback_variable(var_name.id);
         }
 
     } // namespace ast
@@ -8,13 +8,13 @@ namespace hulk {
 
         void function_stmt::scoped_visit(semantic::context& ctx) const {
             for (const auto& param : parameters)
-                ctx.add_variable(param.name.lexeme);
+                ctx.add_variable(param.name.id);
 
             if (body)
                 body->scoped_visit(ctx);
 
             for (const auto& param : parameters)
-                ctx.rollback_variable(param.name.lexeme);
+                ctx.rollback_variable(param.name.id);
         }
 
     } // namespace ast
@@ -7,13 +7,16 @@ namespace hulk {
     namespace ast {
 
         void let_expr::scoped_visit(semantic::context& ctx) const {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
             for (const auto& assignment : assignments)
                 assignment->scoped_visit(ctx);
 
             body->scoped_visit(ctx);
 
             for (const auto& assignment : assignments)
-                ctx.rollback_variable(assignment->name.lexeme);
+                ctx.rollback_variable(assignment->name.id);
         }
 
     } // namespace ast
@@ -7,11 +7,14 @@ namespace hulk {
     namespace ast {
 
         void new_expr::scoped_visit(semantic::context& ctx) const {
-            if (!type_name.lexeme.empty() && !ctx.type_exists(type_name.lexeme)) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
+            if (!type_name.lexeme.empty() && !ctx.type_exists(type_name.get_lexeme())) {
                 internal::error(type_name, "Type does not exist.");
             }
 
-            auto& type = ctx.get_type(type_name.lexeme);
+            auto& type = ctx.get_type(type_name.get_lexeme());
 
             if (type.params.size() != arguments.size()) {
                 internal::error(type_name, "Type expects " + std::to_string(type.params.size()) + " arguments, but got " + std::to_string(arguments.size()) + ".");
@@ -7,6 +7,9 @@ namespace hulk {
     namespace ast {
 
         void unary_expr::scoped_visit(semantic::context& ctx) const {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
             expression->scoped_visit(ctx);
         }
 
@@ -7,14 +7,17 @@ namespace hulk {
     namespace ast {
 
         void var_expr::scoped_visit(semantic::context& ctx) const {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
             if (object) {
-                var_expr* self = dynamic_cast<ast::var_expr*>(object->get());
+                var_expr* self = dynamic_cast<ast::var_expr*>(*object);
                 if (!self || self->object.has_value() || self->name.lexeme != "self") {
                     internal::error(name, "object in var_expr is not 'self'.");
                     return;
                 }
 
-                if (ctx.variable_exists("self")) {
+                if (ctx.variable_exists(lexer::intern("self"))) {
                     internal::error(name, "variable 'self' doesn't have public fields.");
                     return;
                 }
@@ -25,16 +28,16 @@ namespace hulk {
                 }
 
                 auto& type = ctx.get_type(ctx.self);
-                if (!type.has_field(name.lexeme)) {
-                    internal::error(name, "field '" + name.lexeme + "' does not exist in type '" + ctx.self + "'.");
+                if (!type.has_field(name.get_lexeme())) {
+                    internal::error(name, "field '" + name.get_lexeme() + "' does not exist in type '" + ctx.self + "'.");
                 }
             }
             else {
-                if (!ctx.variable_exists(name.lexeme)) {
+                if (!ctx.variable_exists(name.id)) {
                     if(name.lexeme == "self" && !ctx.self.empty())
                         internal::error(name, "self is not a valid read or assigment target.");
                     else 
-                        internal::error(name, "variable '" + name.lexeme + "' does not exist.");
+                        internal::error(name, "variable '" + name.get_lexeme() + "' does not exist.");
                 }
             }
         }
@@ -7,6 +7,9 @@ namespace hulk {
     namespace ast {
 
         void while_expr::scoped_visit(semantic::context& ctx) const {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return scoped_visit(ctx); });
+
             condition->scoped_visit(ctx);
             body->scoped_visit(ctx);
         }
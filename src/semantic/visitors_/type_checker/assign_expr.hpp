@@ -7,11 +7,14 @@ namespace hulk {
     namespace ast {
 
         string assign_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             string var_type = variable->type_check(ctx);
 
             string value_type = value->type_check(ctx);
 
-            if (ctx.get_type(value_type) <= ctx.get_type(var_type));
+            if (ctx.conforms(value_type, var_type));
             else {
                 internal::error(type, "type '" + var_type + "' does not match value type '" + value_type + "'");
             }
@@ -7,32 +7,35 @@ namespace hulk {
     namespace ast {
 
         string binary_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             string left_type = left->type_check(ctx);
             string right_type = right->type_check(ctx);
 
             if (semantic::number_ops.count(op)) {
                 if (left_type != "Number")
-                    internal::error(token, token.lexeme + " left operand is not a number");
+                    internal::error(token, token.get_lexeme() + " left operand is not a number");
                 if (right_type != "Number")
-                    internal::error(token, token.lexeme + " right operand is not a number");
+                    internal::error(token, token.get_lexeme() + " right operand is not a number");
 
                 return "Number";
             }
 
             if (semantic::boolean_ops.count(op)) {
                 if (left_type != "Boolean")
-                    internal::error(token, token.lexeme + " left operand is not a boolean");
+                    internal::error(token, token.get_lexeme() + " left operand is not a boolean");
                 if (right_type != "Boolean")
-                    internal::error(token, token.lexeme + " right operand is not a boolean");
+                    internal::error(token, token.get_lexeme() + " right operand is not a boolean");
 
                 return "Boolean";
             }
 
             if (semantic::comparison_ops.count(op)) {
                 if (left_type != "Number")
-                    internal::error(token, token.lexeme + " left operand is not a number");
+                    internal::error(token, token.get_lexeme() + " left operand is not a number");
                 if (right_type != "Number")
-                    internal::error(token, token.lexeme + " right operand is not a number");
+                    internal::error(token, token.get_lexeme() + " right operand is not a number");
 
                 return "Boolean";
             }
@@ -43,15 +46,15 @@ namespace hulk {
 
             if (semantic::string_ops.count(op)) {
                 if (left_type != "String" && left_type != "Number")
-                    internal::error(token, token.lexeme + " left operand is not a string");
+                    internal::error(token, token.get_lexeme() + " left operand is not a string");
                 if (right_type != "String" && right_type != "Number")
-                    internal::error(token, token.lexeme + " right operand is not a string");
+                    internal::error(token, token.get_lexeme() + " right operand is not a string");
 
                 return "String";
             }
 
             // unknown operator
-            internal::error(token, "unknown operator: " + token.lexeme);
+            internal::error(token, "unknown operator: " + token.get_lexeme());
             return "Object";
         }
 
@@ -7,6 +7,9 @@ namespace hulk {
     namespace ast {
 
         string block_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             string last_type = "Object";
 
             for (int i = 0; i < expressions.size(); ++i)
@@ -7,38 +7,39 @@ namespace hulk {
     namespace ast {
 
         string call_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             if (object.has_value()) {
                 string obj_type = object.value()->type_check(ctx);
-                auto& obj = ctx.get_type(obj_type);
-
-                auto& method = obj.get_method(callee.lexeme);
+                auto& method = ctx.get_method(ctx.get_type_id(obj_type), callee.get_lexeme());
 
                 for (size_t i = 0; i < arguments.size(); ++i) {
                     string arg_type = arguments[i]->type_check(ctx);
-                    if (ctx.get_type(arg_type) <= *method.params[i].attr_type);
+                    if (ctx.conforms(ctx.get_type_id(arg_type), method.params[i].attr_type));
                     else {
                         internal::error(callee,
-                            "Method '" + callee.lexeme + "' expects argument " + std::to_string(i + 1) +
-                            " of type '" + method.params[i].attr_type->name + "', but got '" + arg_type + "'");
+                            "Method '" + callee.get_lexeme() + "' expects argument " + std::to_string(i + 1) +
+                            " of type '" + ctx.type_name(method.params[i].attr_type) + "', but got '" + arg_type + "'");
                     }
                 }
 
-                return method.return_type->name;
+                return ctx.type_name(method.return_type);
             }
             else {
-                auto& func = ctx.get_function(callee.lexeme);
+                auto& func = ctx.get_function(callee.get_lexeme());
 
                 for (size_t i = 0; i < arguments.size(); ++i) {
                     string arg_type = arguments[i]->type_check(ctx);
-                    if (ctx.get_type(arg_type) <= *func.params[i].attr_type);
+                    if (ctx.conforms(ctx.get_type_id(arg_type), func.params[i].attr_type));
                     else {
                         internal::error(callee,
-                            "Function '" + callee.lexeme + "' expects argument " + std::to_string(i + 1) +
-                            " of type '" + func.params[i].attr_type->name + "', but got '" + arg_type + "'");
+                            "Function '" + callee.get_lexeme() + "' expects argument " + std::to_string(i + 1) +
+                            " of type '" + ctx.type_name(func.params[i].attr_type) + "', but got '" + arg_type + "'");
                     }
                 }
 
-                return func.return_type->name;
+                return ctx.type_name(func.return_type);
             }
         }
 
@@ -6,15 +6,15 @@
 namespace hulk {
     namespace ast {
 
-        void check_override(semantic::type& this_type, lexer::token name) {
-            auto parent = this_type.parent;
+        void check_override(semantic::context& ctx, semantic::type& this_type, lexer::token name) {
+            semantic::type_id parent = this_type.parent;
 
-            while (parent) {
+            while (parent != semantic::no_type) {
                 bool error = false;
                 
                 for (const auto& method : this_type.methods) {
-                    if (parent->has_method(method.name)) {
-                        auto& parent_method = parent->get_method(method.name);
+                    if (ctx.has_method(parent, method.name)) {
+                        auto& parent_method = ctx.get_method(parent, method.name);
 
                         if (method.return_type != parent_method.return_type) {
                             internal::error(name, "error overriding method " + method.name + ", doesn't have the same signature in return type");
@@ -39,31 +39,31 @@ namespace hulk {
                 if (error)
                     return;
 
-                parent = parent->parent;
+                parent = ctx.get_type(parent).parent;
             }
         }
 
         void class_stmt::type_check(semantic::context& ctx) const {
-            auto& this_type = ctx.get_type(name.lexeme);
+            auto& this_type = ctx.get_type(name.get_lexeme());
 
             for (const auto& param : parameters)
-                ctx.add_variable(param.name.lexeme, param.type.lexeme);
+                ctx.add_variable(param.name.id, param.type.get_lexeme());
 
             if (super_class.has_value()) {
-                auto& parent_type = ctx.get_type(super_class.value()->name.lexeme);
+                auto& parent_type = ctx.get_type(super_class.value()->name.get_lexeme());
                 auto& parent_args = super_class.value()->init;
 
                 for (int i = 0; i < parent_args.size(); ++i) {
                     string arg_type = parent_args[i]->type_check(ctx);
-                    if (ctx.get_type(arg_type) <= *parent_type.params[i].attr_type);
+                    if (ctx.conforms(ctx.get_type_id(arg_type), parent_type.params[i].attr_type));
                     else {
                         internal::error(super_class.value()->name,
-                            "type '" + name.lexeme + "' expects argument " + std::to_string(i + 1) +
-                            " of type '" + parent_type.params[i].attr_type->name + "', but got '" + arg_type + "'");
+                            "type '" + name.get_lexeme() + "' expects argument " + std::to_string(i + 1) +
+                            " of type '" + ctx.type_name(parent_type.params[i].attr_type) + "', but got '" + arg_type + "'");
                     }
                 }
 
-                check_override(this_type, name);
+                check_override(ctx, this_type, name);
             }
 
             for (const auto& field : fields) {
@@ -71,9 +71,9 @@ namespace hulk {
             }
 
             for (const auto& param : parameters)
-                ctx.rollback_variable(param.name.lexeme);
+                ctx.rollback_variable(param.name.id);
 
-            ctx.self = name.lexeme;
+            ctx.self = name.get_lexeme();
 
             for (const auto& method : methods)
                 method->type_check(ctx);
@@ -7,16 +7,19 @@ namespace hulk {
     namespace ast {
 
         string declaration_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             string value_type = value->type_check(ctx);
 
-            if (ctx.get_type(value_type) <= ctx.get_type(type.lexeme));
+            if (ctx.conforms(value_type, type.get_lexeme()));
             else {
-                internal::error(name, "type '" + type.lexeme + "' does not match value type '" + value_type + "'");
+                internal::error(name, "type '" + type.get_lexeme() + "' does not match value type '" + value_type + "'");
             }
 
-            ctx.add_variable(name.lexeme, type.lexeme);
+            ctx.add_variable(name.id, type.get_lexeme());
 
-            return type.lexeme;
+            return type.get_lexeme();
         }
 
     } // namespace ast
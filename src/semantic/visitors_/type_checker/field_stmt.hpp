@@ -9,10 +9,10 @@ namespace hulk {
         void field_stmt::type_check(semantic::context& ctx) const {
             string value_type = initializer->type_check(ctx);
 
-            if (ctx.get_type(value_type) <= ctx.get_type(type.lexeme));
+            if (ctx.conforms(value_type, type.get_lexeme()));
             else {
                 internal::error(name,
-                    "field '" + name.lexeme + "' expects type '" + type.lexeme +
+                    "field '" + name.get_lexeme() + "' expects type '" + type.get_lexeme() +
                     "', but got '" + value_type + "'");
             }
         }
@@ -7,28 +7,31 @@ namespace hulk {
     namespace ast {
 
         string for_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             string iterable_type = iterable->type_check(ctx);
-            auto& iter_type = ctx.get_type(iterable_type);
+            semantic::type_id iter_type = ctx.get_type_id(iterable_type);
 
-            if (iter_type <= ctx.get_type("Iterable")) {
-                auto& current_method = iter_type.get_method("current");
+            if (ctx.conforms(iter_type, ctx.get_type_id("Iterable"))) {
+                auto& current_method = ctx.get_method(iter_type, "current");
 
-                if (*current_method.return_type <= ctx.get_type(var_type.lexeme));
+                if (ctx.conforms(current_method.return_type, ctx.get_type_id(var_type.get_lexeme())));
                 else {
                     internal::error(var_name,
-                        "type '" + var_type.lexeme + "' does not match iterable's current type '" + current_method.return_type->name + "'");
+                        "type '" + var_type.get_lexeme() + "' does not match iterable's current type '" + ctx.type_name(current_method.return_type) + "'");
                 }
             }
-            else if (iter_type <= ctx.get_type("Enumerable")) {
-                auto& iter_method = iter_type.get_method("iter");
+            else if (ctx.conforms(iter_type, ctx.get_type_id("Enumerable"))) {
+                auto& iter_method = ctx.get_method(iter_type, "iter");
 
-                iter_type = *iter_method.return_type;
-                auto& current_method = iter_type.get_method("current");
+                iter_type = iter_method.return_type;
+                auto& current_method = ctx.get_method(iter_type, "current");
 
-                if (*current_method.return_type <= ctx.get_type(var_type.lexeme));
+                if (ctx.conforms(current_method.return_type, ctx.get_type_id(var_type.get_lexeme())));
                 else {
                     internal::error(var_name,
-                        "type '" + var_type.lexeme + "' does not match iterable's current type '" + current_method.return_type->name + "'");
+                        "type '" + var_type.get_lexeme() + "' does not match iterable's current type '" + ctx.type_name(current_method.return_type) + "'");
                 }
             }
             else {
@@ -36,11 +39,11 @@ namespace hulk {
                     "iterable is not an Iterable or Enumerable, got '" + iterable_type + "'");
             }
 
-            ctx.add_variable(var_name.lexeme, var_type.lexeme);
+            ctx.add_variable(var_name.id, var_type.get_lexeme());
 
             string body_type = body->type_check(ctx);
 
-            ctx.rollback_variable(var_name.lexeme);
+            ctx.rollback_variable(var_name.id);
 
             return body_type;
         }
@@ -8,13 +8,13 @@ namespace hulk {
 
         void function_stmt::type_check(semantic::context& ctx) const {
             for (const auto& param : parameters)
-                ctx.add_variable(param.name.lexeme, param.type.lexeme);
+                ctx.add_variable(param.name.id, param.type.get_lexeme());
 
             if (body)
                 body->type_check(ctx);
 
             for (const auto& param : parameters)
-                ctx.rollback_variable(param.name.lexeme);
+                ctx.rollback_variable(param.name.id);
         }
 
     } // namespace ast
@@ -7,9 +7,12 @@ namespace hulk {
     namespace ast {
 
         string if_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             string cond_type = condition->type_check(ctx);
 
-            if (ctx.get_type(cond_type) == ctx.get_type("Boolean"));
+            if (ctx.get_type_id(cond_type) == ctx.get_type_id("Boolean"));
             else {
                 internal::error(condition_token.line, condition_token.column, "condition is not a boolean, got '" + cond_type + "'");
             }
@@ -18,19 +21,19 @@ namespace hulk {
             int idx = 0;
             for (const auto& elif : elif_branchs) {
                 string elif_cond_type = elif.first->type_check(ctx);
-                if (ctx.get_type(elif_cond_type) == ctx.get_type("Boolean"));
+                if (ctx.get_type_id(elif_cond_type) == ctx.get_type_id("Boolean"));
                 else {
                     internal::error(elif_tokens[idx].line, elif_tokens[idx].column, "elif condition is not a boolean, got '" + elif_cond_type + "'");
                 }
                 idx++;
 
                 string elif_type = elif.second->type_check(ctx);
-                then_type = ctx.get_lca_type(&ctx.get_type(then_type), &ctx.get_type(elif_type))->name;
+                then_type = ctx.get_lca_type(then_type, elif_type);
             }
 
             if (else_branch.has_value()) {
                 string else_type = else_branch.value()->type_check(ctx);
-                then_type = ctx.get_lca_type(&ctx.get_type(then_type), &ctx.get_type(else_type))->name;
+                then_type = ctx.get_lca_type(then_type, else_type);
             }
 
             return then_type;
@@ -7,13 +7,16 @@ namespace hulk {
     namespace ast {
 
         string let_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             for (const auto& assignment : assignments)
                 assignment->type_check(ctx);
 
             string body_type = body->type_check(ctx);
 
             for (const auto& assignment : assignments)
-                ctx.rollback_variable(assignment->name.lexeme);
+                ctx.rollback_variable(assignment->name.id);
 
             return body_type;
         }
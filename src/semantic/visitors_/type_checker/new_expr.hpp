@@ -7,20 +7,23 @@ namespace hulk {
     namespace ast {
 
         string new_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             int args_count = arguments.size();
-            auto& current = ctx.get_type(type_name.lexeme);
+            auto& current = ctx.get_type(type_name.get_lexeme());
 
             for (int i = 0; i < args_count; ++i) {
                 string arg_type = arguments[i]->type_check(ctx);
-                if (ctx.get_type(arg_type) <= *current.params[i].attr_type);
+                if (ctx.conforms(ctx.get_type_id(arg_type), current.params[i].attr_type));
                 else {
                     internal::error(type_name,
-                        "type '" + type_name.lexeme + "' expects argument " + std::to_string(i + 1) +
-                        " of type '" + current.params[i].attr_type->name + "', but got '" + arg_type + "'");
+                        "type '" + type_name.get_lexeme() + "' expects argument " + std::to_string(i + 1) +
+                        " of type '" + ctx.type_name(current.params[i].attr_type) + "', but got '" + arg_type + "'");
                 }
             }
 
-            return type_name.lexeme;
+            return type_name.get_lexeme();
         }
 
     } // namespace ast
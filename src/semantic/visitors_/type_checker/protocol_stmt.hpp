@@ -7,15 +7,17 @@ namespace hulk {
     namespace ast {
 
         void protocol_stmt::type_check(semantic::context& ctx) const {
-            auto& protocol = ctx.get_type(name.lexeme);
-            auto& parent = *protocol.parent;
+            auto& protocol = ctx.get_type(name.get_lexeme());
+            semantic::type_id parent = protocol.parent;
+            if (parent == semantic::no_type)
+                return;
 
             for (const auto& method : protocol.methods) {
-                if (!parent.has_method(method.name))
+                if (!ctx.has_method(parent, method.name))
                     continue;
 
-                auto& parent_method = parent.get_method(method.name);
-                if (method.return_type <= parent_method.return_type);
+                auto& parent_method = ctx.get_method(parent, method.name);
+                if (ctx.conforms(method.return_type, parent_method.return_type));
                 else {
                     internal::error(name, "can't extends protocol, return types are not covariant.");
                 }
@@ -26,7 +28,7 @@ namespace hulk {
                 }
 
                 for (size_t i = 0; i < method.params.size(); ++i)
-                    if (parent_method.params[i].attr_type <= method.params[i].attr_type);
+                    if (ctx.conforms(parent_method.params[i].attr_type, method.params[i].attr_type));
                     else {
                         internal::error(name, "can't extends protocol, " + method.name + "argument " + std::to_string(i) + " are not contravariant.");
                     }
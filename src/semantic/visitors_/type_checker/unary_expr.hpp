@@ -7,24 +7,27 @@ namespace hulk {
     namespace ast {
 
         string unary_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             string expr_type = expression->type_check(ctx);
 
             if (op == unary_op::MINUS) {
                 if (expr_type != "Number")
-                    internal::error(token, token.lexeme + " operand is not a number");
+                    internal::error(token, token.get_lexeme() + " operand is not a number");
 
                 return "Number";
             }
 
             if (op == unary_op::NOT) {
                 if (expr_type != "Boolean")
-                    internal::error(token, token.lexeme + " operand is not a boolean");
+                    internal::error(token, token.get_lexeme() + " operand is not a boolean");
 
                 return "Boolean";
             }
 
             // unknown operator
-            internal::error(token, "unknown operator: " + token.lexeme);
+            internal::error(token, "unknown operator: " + token.get_lexeme());
             return "Object";
         }
 
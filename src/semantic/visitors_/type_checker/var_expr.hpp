@@ -6,18 +6,21 @@ namespace hulk {
     namespace ast {
 
         string var_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             if (object.has_value()) {
                 string _type = object.value()->type_check(ctx);
                 auto& obj_type = ctx.get_type(_type);
 
-                auto& field = obj_type.get_field(name.lexeme);
-                return field.attr_type->name;
+                auto& field = obj_type.get_field(name.get_lexeme());
+                return ctx.type_name(field.attr_type);
             }
             else {
-                if (name.lexeme == "self" && !ctx.variable_exists(name.lexeme))
+                if (name.lexeme == "self" && !ctx.variable_exists(name.id))
                     return ctx.self;
 
-                auto& var_type = ctx.get_variable_type(name.lexeme);
+                auto& var_type = ctx.get_variable_type(name.id);
                 return var_type;
             }
         }
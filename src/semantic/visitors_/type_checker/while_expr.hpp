@@ -7,9 +7,12 @@ namespace hulk {
     namespace ast {
 
         string while_expr::type_check(semantic::context& ctx) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return type_check(ctx); });
+
             string cond_type = condition->type_check(ctx);
 
-            if (ctx.get_type(cond_type) == ctx.get_type("Boolean"));
+            if (ctx.get_type_id(cond_type) == ctx.get_type_id("Boolean"));
             else {
                 internal::error(condition_token.line, condition_token.column, "condition is not a boolean, got '" + cond_type + "'");
             }
@@ -8,6 +8,9 @@ namespace hulk {
     namespace ast {
 
         string assign_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             string inferred_type = variable->infer(ctx, shouldbe_type);
             return value->infer(ctx, inferred_type);
         }
@@ -8,6 +8,9 @@ namespace hulk {
     namespace ast {
 
         string binary_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             if (semantic::number_ops.count(op)) {
                 left->infer(ctx, "Number");
                 right->infer(ctx, "Number");
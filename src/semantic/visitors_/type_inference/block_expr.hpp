@@ -8,6 +8,9 @@ namespace hulk {
     namespace ast {
 
         string block_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             for (int i = 0; i < expressions.size() - 1; ++i)
                 expressions[i]->infer(ctx);
 
@@ -8,6 +8,9 @@ namespace hulk {
     namespace ast {
 
         string call_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             if (object.has_value()) {
                 string object_type = object.value()->infer(ctx);
 
@@ -15,27 +18,27 @@ namespace hulk {
                     return shouldbe_type; // If object type is not inferred, return expected type
                 }
 
-                auto& type = ctx.get_type(object_type);
+                semantic::type_id type = ctx.get_type_id(object_type);
 
-                if (!type.has_method(callee.lexeme)) {
-                    semantic::add_infer_error(callee.line, callee.column, "Method '" + callee.lexeme + "' does not exist in type '" + object_type + "'.");
+                if (!ctx.has_method(type, callee.get_lexeme())) {
+                    semantic::add_infer_error(callee.line, callee.column, "Method '" + callee.get_lexeme() + "' does not exist in type '" + object_type + "'.");
                     return shouldbe_type; // If method does not exist, return expected type
                 }
 
-                auto& method = type.get_method(callee.lexeme);
+                auto& method = ctx.get_method(type, callee.get_lexeme());
                 if (method.params.size() != arguments.size()) {
                     semantic::add_infer_error(callee.line, callee.column,
-                        "Method '" + callee.lexeme + "' expects " + std::to_string(method.params.size()) +
+                        "Method '" + callee.get_lexeme() + "' expects " + std::to_string(method.params.size()) +
                         " arguments, but got " + std::to_string(arguments.size()) + ".");
                     return shouldbe_type; // If argument count does not match, return expected type
                 }
 
                 for (size_t i = 0; i < arguments.size(); ++i) {
-                    arguments[i]->infer(ctx, method.params[i].attr_type->name);
+                    arguments[i]->infer(ctx, ctx.type_name(method.params[i].attr_type));
                 }
 
-                if (method.return_type)
-                    return method.return_type->name;
+                if (method.return_type != semantic::no_type)
+                    return ctx.type_name(method.return_type);
 
                 return shouldbe_type; // If method return type is not defined, return expected type
             }
@@ -44,14 +47,14 @@ namespace hulk {
                     return arguments[0]->infer(ctx,"Object");
                 }
 
-                auto& func = ctx.get_function(callee.lexeme);
+                auto& func = ctx.get_function(callee.get_lexeme());
 
                 for (size_t i = 0; i < arguments.size(); ++i) {
-                    arguments[i]->infer(ctx, func.params[i].attr_type->name);
+                    arguments[i]->infer(ctx, ctx.type_name(func.params[i].attr_type));
                 }
 
-                if (func.return_type)
-                    return func.return_type->name;
+                if (func.return_type != semantic::no_type)
+                    return ctx.type_name(func.return_type);
 
                 return shouldbe_type; // If function return type is not defined, return expected type
             }
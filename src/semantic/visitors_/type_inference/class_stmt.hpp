@@ -8,17 +8,17 @@ namespace hulk {
     namespace ast {
 
         string class_stmt::infer(semantic::context& ctx, const string& shouldbe_type) {
-            auto& this_type = ctx.get_type(name.lexeme);
+            auto& this_type = ctx.get_type(name.get_lexeme());
 
             for (const auto& param : parameters)
-                ctx.add_variable(param.name.lexeme, param.type.lexeme);
+                ctx.add_variable(param.name.id, param.type.get_lexeme());
 
             if (super_class.has_value()) {
-                auto& parent_type = ctx.get_type(super_class.value()->name.lexeme);
+                auto& parent_type = ctx.get_type(super_class.value()->name.get_lexeme());
 
                 auto& parent_args = super_class.value()->init;
                 for (int i = 0; i < parent_args.size(); ++i) {
-                    parent_args[i]->infer(ctx, parent_type.params[i].attr_type->name);
+                    parent_args[i]->infer(ctx, ctx.type_name(parent_type.params[i].attr_type));
                 }
             }
 
@@ -27,8 +27,8 @@ namespace hulk {
                 string inferred_type = field->infer(ctx);
 
                 // Add inferred type to context
-                if (!this_type.fields[idx].attr_type && inferred_type != "") {
-                    this_type.fields[idx].attr_type = std::make_shared<semantic::type>(ctx.get_type(inferred_type));
+                if (this_type.fields[idx].attr_type == semantic::no_type && inferred_type != "") {
+                    this_type.fields[idx].attr_type = ctx.get_type_id(inferred_type);
                 }
                 idx++;
             }
@@ -37,10 +37,10 @@ namespace hulk {
             for (auto& param : parameters) {
                 if (param.type.lexeme.empty()) {
                     // Infer param type
-                    param.type.lexeme = ctx.get_variable_type(param.name.lexeme);
+                    param.type.set_lexeme(ctx.get_variable_type(param.name.id));
 
                     if (param.type.lexeme != "") {
-                        this_type.params[idx].attr_type = make_shared<semantic::type>(ctx.get_type(param.type.lexeme));
+                        this_type.params[idx].attr_type = ctx.get_type_id(param.type.get_lexeme());
                         semantic::repeat_infer = true;
                     }
                     else {
@@ -49,19 +49,19 @@ namespace hulk {
 
                 }
                 idx++;
-                ctx.rollback_variable(param.name.lexeme);
+                ctx.rollback_variable(param.name.id);
             }
 
-            ctx.self = name.lexeme;
+            ctx.self = name.get_lexeme();
 
             for (auto& meth : methods) {
-                semantic::method& func = this_type.get_method(meth->name.lexeme);
+                semantic::method& func = ctx.get_method(this_type.id, meth->name.get_lexeme());
 
                 for (const auto& param : meth->parameters) {
-                    ctx.add_variable(param.name.lexeme, param.type.lexeme);
+                    ctx.add_variable(param.name.id, param.type.get_lexeme());
                 }
 
-                string inferred_type = meth->body->infer(ctx, meth->return_type.lexeme);
+                string inferred_type = meth->body->infer(ctx, meth->return_type.get_lexeme());
 
                 // Infer return type if not specified
                 if (meth->return_type.lexeme.empty()) {
@@ -69,8 +69,9 @@ namespace hulk {
                         semantic::add_infer_error(name.line, name.column, "return type not inferred");
                     }
                     else {
-                        meth->return_type.lexeme = inferred_type;
-                        func.return_type = std::make_shared<semantic::type>(ctx.get_type(meth->return_type.lexeme));
+                        meth->return_type.set_lexeme(inferred_type);
+                        func.return_type = ctx.get_type_id(meth->return_type.get_lexeme());
+                        ctx.types.signatures_changed();
                         semantic::repeat_infer = true; // If return type was inferred, we need to repeat inference
                     }
                 }
@@ -78,24 +79,25 @@ namespace hulk {
                 for (auto& param : meth->parameters) {
                     // Infer parameter type if not specified
                     if (param.type.lexeme.empty()) {
-                        inferred_type = ctx.get_variable_type(param.name.lexeme);
+                        inferred_type = ctx.get_variable_type(param.name.id);
                         if (inferred_type.empty()) {
                             semantic::add_infer_error(param.name.line, param.name.column, "parameter type not inferred");
                         }
                         else {
-                            param.type.lexeme = inferred_type;
-                            func.get_param(param.name.lexeme).attr_type = std::make_shared<semantic::type>(ctx.get_type(param.type.lexeme));
+                            param.type.set_lexeme(inferred_type);
+                            func.get_param(param.name.get_lexeme()).attr_type = ctx.get_type_id(param.type.get_lexeme());
+                            ctx.types.signatures_changed();
                             semantic::repeat_infer = true; // If parameter type was inferred, we need to repeat inference
                         }
                     }
 
-                    ctx.rollback_variable(param.name.lexeme);
+                    ctx.rollback_variable(param.name.id);
                 }
             }
 
             ctx.self = "";
 
-            return name.lexeme; // Ignore return type for type definitions
+            return name.get_lexeme(); // Ignore return type for type definitions
         }
 
     } // namespace ast
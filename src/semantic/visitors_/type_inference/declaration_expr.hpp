@@ -8,23 +8,26 @@ namespace hulk {
     namespace ast {
 
         string declaration_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             if (value) {
-                string inferred_type = value->infer(ctx, type.lexeme);
+                string inferred_type = value->infer(ctx, type.get_lexeme());
 
                 if (type.lexeme.empty()) {
                     if (inferred_type.empty()) {
                         semantic::add_infer_error(name.line, name.column, "variable type not inferred, is necessary to annotate it.");
                     }
                     else {
-                        type.lexeme = inferred_type;
+                        type.set_lexeme(inferred_type);
                         semantic::repeat_infer = true;
                     }
                 }
             }
 
-            ctx.add_variable(name.lexeme, type.lexeme);
+            ctx.add_variable(name.id, type.get_lexeme());
 
-            return type.lexeme;
+            return type.get_lexeme();
         }
 
     } // namespace ast
@@ -8,16 +8,19 @@ namespace hulk {
     namespace ast {
 
         string for_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             string inferred_iter_type = iterable->infer(ctx, "Iterable");
 
             if (!inferred_iter_type.empty()) {
-                auto& iter_type = ctx.get_type(inferred_iter_type);
+                semantic::type_id iter_type = ctx.get_type_id(inferred_iter_type);
 
-                if (iter_type.has_method("current")) {
-                    auto& current_method = iter_type.get_method("current");
+                if (ctx.has_method(iter_type, "current")) {
+                    auto& current_method = ctx.get_method(iter_type, "current");
 
                     if (var_type.lexeme.empty()) {
-                        var_type.lexeme = current_method.return_type->name;
+                        var_type.set_lexeme(ctx.type_name(current_method.return_type));
                         semantic::repeat_infer = true; // Repeat inference if type was inferred
                     }
                 }
@@ -27,11 +30,11 @@ namespace hulk {
                 semantic::add_infer_error(var_name.line, var_name.column, "variable type was not inferred, is necessary to annotate it.");
             }
 
-            ctx.add_variable(var_name.lexeme, var_type.lexeme);
+            ctx.add_variable(var_name.id, var_type.get_lexeme());
 
             string body_type = body->infer(ctx, shouldbe_type);
 
-            ctx.rollback_variable(var_name.lexeme);
+            ctx.rollback_variable(var_name.id);
 
             if (body_type.empty()) {
                 body_type = shouldbe_type; // If body type is not inferred, return the expected type
@@ -8,13 +8,13 @@ namespace hulk {
     namespace ast {
 
         string function_stmt::infer(semantic::context& ctx, const string& shouldbe_type) {
-            auto& func = ctx.get_function(name.lexeme);
+            auto& func = ctx.get_function(name.get_lexeme());
 
             for (const auto& param : parameters) {
-                ctx.add_variable(param.name.lexeme, param.type.lexeme);
+                ctx.add_variable(param.name.id, param.type.get_lexeme());
             }
 
-            string inferred_type = body->infer(ctx, return_type.lexeme);
+            string inferred_type = body->infer(ctx, return_type.get_lexeme());
 
             // Infer return type if not specified
             if (return_type.lexeme.empty()) {
@@ -22,8 +22,8 @@ namespace hulk {
                     semantic::add_infer_error(name.line, name.column, "return type not inferred, is necessary to annotate it.");
                 }
                 else {
-                    return_type.lexeme = inferred_type;
-                    func.return_type = std::make_shared<semantic::type>(ctx.get_type(return_type.lexeme));
+                    return_type.set_lexeme(inferred_type);
+                    func.return_type = ctx.get_type_id(return_type.get_lexeme());
                     semantic::repeat_infer = true; // If return type was inferred, we need to repeat inference
                 }
             }
@@ -31,21 +31,21 @@ namespace hulk {
             for (auto& param : parameters) {
                 // Infer parameter type if not specified
                 if (param.type.lexeme.empty()) {
-                    inferred_type = ctx.get_variable_type(param.name.lexeme);
+                    inferred_type = ctx.get_variable_type(param.name.id);
                     if (inferred_type.empty()) {
                         semantic::add_infer_error(param.name.line, param.name.column, "parameter type not inferred, is necessary to annotate it.");
                     }
                     else {
-                        param.type.lexeme = inferred_type;
-                        func.get_param(param.name.lexeme).attr_type = std::make_shared<semantic::type>(ctx.get_type(param.type.lexeme));
+                        param.type.set_lexeme(inferred_type);
+                        func.get_param(param.name.get_lexeme()).attr_type = ctx.get_type_id(param.type.get_lexeme());
                         semantic::repeat_infer = true; // If parameter type was inferred, we need to repeat inference
                     }
                 }
 
-                ctx.rollback_variable(param.name.lexeme);
+                ctx.rollback_variable(param.name.id);
             }
 
-            return return_type.lexeme;
+            return return_type.get_lexeme();
         }
 
     } // namespace ast
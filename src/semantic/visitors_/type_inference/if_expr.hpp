@@ -8,6 +8,9 @@ namespace hulk {
     namespace ast {
 
         string if_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             condition->infer(ctx, "Boolean");
 
             string then_type = then_branch->infer(ctx, shouldbe_type);
@@ -19,7 +22,7 @@ namespace hulk {
 
                 if (then_type.empty() || elif_type.empty());
                 else
-                    then_type = ctx.get_lca_type(&ctx.get_type(then_type), &ctx.get_type(elif_type))->name;
+                    then_type = ctx.get_lca_type(then_type, elif_type);
             }
 
             if (else_branch.has_value()) {
@@ -27,7 +30,7 @@ namespace hulk {
 
                 if (then_type.empty() || else_type.empty());
                 else
-                    then_type = ctx.get_lca_type(&ctx.get_type(then_type), &ctx.get_type(else_type))->name;
+                    then_type = ctx.get_lca_type(then_type, else_type);
             }
 
             if (then_type.empty())
@@ -8,13 +8,16 @@ namespace hulk {
     namespace ast {
 
         string let_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             for (const auto& assignment : assignments)
                 assignment->infer(ctx);
 
             string inferred_type = body->infer(ctx, shouldbe_type);
 
             for(const auto& assignment : assignments)
-                ctx.rollback_variable(assignment->name.lexeme);
+                ctx.rollback_variable(assignment->name.id);
 
             return inferred_type;
         }
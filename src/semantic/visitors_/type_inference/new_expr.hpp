@@ -8,13 +8,16 @@ namespace hulk {
     namespace ast {
 
         string new_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
-            auto& type = ctx.get_type(type_name.lexeme);
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
+            auto& type = ctx.get_type(type_name.get_lexeme());
 
             for (int i = 0; i < arguments.size(); ++i) {
-                arguments[i]->infer(ctx, type.params[i].attr_type->name);
+                arguments[i]->infer(ctx, ctx.type_name(type.params[i].attr_type));
             }
 
-            return type_name.lexeme; // Return the type of the new expression
+            return type_name.get_lexeme(); // Return the type of the new expression
         }
 
     } // namespace ast
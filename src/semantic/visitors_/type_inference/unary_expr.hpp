@@ -8,6 +8,9 @@ namespace hulk {
     namespace ast {
 
         string unary_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             if (ast::unary_op::MINUS == op) {
                 expression->infer(ctx, "Number");
                 return "Number";
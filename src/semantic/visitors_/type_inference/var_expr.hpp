@@ -8,23 +8,26 @@ namespace hulk {
     namespace ast {
 
         string var_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             if (object.has_value()) {
                 string inferred_type = object.value()->infer(ctx);
 
                 auto& obj_type = ctx.get_type(inferred_type);
 
-                auto& field = obj_type.get_field(name.lexeme);
+                auto& field = obj_type.get_field(name.get_lexeme());
 
-                if (!field.attr_type)
+                if (field.attr_type == semantic::no_type)
                     return shouldbe_type; // If field type is not set, return the expected type
 
-                return field.attr_type->name; // Return the type of the field
+                return ctx.type_name(field.attr_type); // Return the type of the field
             }
             else {
-                if(name.lexeme == "self" && !ctx.variable_exists(name.lexeme)) 
+                if(name.lexeme == "self" && !ctx.variable_exists(name.id)) 
                     return ctx.self;
                 
-                auto& var_type = ctx.get_variable_type(name.lexeme);
+                auto& var_type = ctx.get_variable_type(name.id);
 
                 if (var_type.empty()) {
                     var_type = shouldbe_type; // If variable type is not set, use the expected type
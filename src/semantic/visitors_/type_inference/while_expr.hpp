@@ -8,6 +8,9 @@ namespace hulk {
     namespace ast {
 
         string while_expr::infer(semantic::context& ctx, const string& shouldbe_type) {
+            if (internal::stack_exhausted())
+                return internal::grow_stack([&] { return infer(ctx, shouldbe_type); });
+
             condition->infer(ctx, "Boolean");
             return body->infer(ctx, shouldbe_type);
         }